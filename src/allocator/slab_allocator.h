@@ -0,0 +1,229 @@
+#ifndef S21_SLAB_ALLOCATOR_H
+#define S21_SLAB_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+
+// Арена одинаковых ячеек: память нарезается из крупных блоков (slab), а
+// освобожденные ячейки уходят в список свободных и переиспользуются.
+// Размер ячейки фиксируется при первом выделении. Не потокобезопасна.
+class SlabArena {
+ public:
+  SlabArena() = default;
+  SlabArena(const SlabArena &) = delete;
+  SlabArena &operator=(const SlabArena &) = delete;
+  ~SlabArena() { release(); }
+
+  void *allocate(std::size_t cell_size);  // nullptr if cell_size is foreign
+  void deallocate(void *cell) noexcept;   // returns the cell to the free list
+  void release() noexcept;                // frees every slab at once
+  void adopt(SlabArena &other) noexcept;  // takes over other's slabs
+  std::size_t cell_size() const noexcept { return cell_size_; }
+
+ private:
+  struct Link {
+    Link *next_;
+  };
+
+  static constexpr std::size_t kAlign = alignof(std::max_align_t);
+  static constexpr std::size_t kFirstSlabCells = 64;
+  static constexpr std::size_t kMaxSlabCells = 1 << 16;
+
+  void grow_();
+
+  Link *slabs_ = nullptr;
+  Link *free_ = nullptr;
+  char *cursor_ = nullptr;
+  char *limit_ = nullptr;
+  std::size_t cell_size_ = 0;
+  std::size_t slab_cells_ = kFirstSlabCells;
+};
+
+inline void *SlabArena::allocate(std::size_t cell_size) {
+  if (cell_size < sizeof(Link)) cell_size = sizeof(Link);
+  if (cell_size_ == 0) cell_size_ = cell_size;
+  if (cell_size != cell_size_) return nullptr;
+  if (free_ != nullptr) {
+    Link *cell = free_;
+    free_ = free_->next_;
+    return cell;
+  }
+  if (cursor_ == limit_) grow_();
+  void *cell = cursor_;
+  cursor_ += cell_size_;
+  return cell;
+}
+
+inline void SlabArena::deallocate(void *cell) noexcept {
+  Link *link = static_cast<Link *>(cell);
+  link->next_ = free_;
+  free_ = link;
+}
+
+inline void SlabArena::release() noexcept {
+  while (slabs_ != nullptr) {
+    Link *next = slabs_->next_;
+    ::operator delete(slabs_);
+    slabs_ = next;
+  }
+  free_ = nullptr;
+  cursor_ = nullptr;
+  limit_ = nullptr;
+  slab_cells_ = kFirstSlabCells;
+}
+
+// Блоки other переходят к этой арене вместе со свободными ячейками, так что
+// узлы, выделенные в other (например, в другом потоке), можно освобождать
+// здесь. Размеры ячеек должны совпадать.
+inline void SlabArena::adopt(SlabArena &other) noexcept {
+  if (other.slabs_ == nullptr) return;
+  if (cell_size_ == 0) cell_size_ = other.cell_size_;
+  for (char *cell = other.cursor_; cell != other.limit_;
+       cell += other.cell_size_) {
+    deallocate(cell);
+  }
+  while (other.free_ != nullptr) {
+    Link *next = other.free_->next_;
+    deallocate(other.free_);
+    other.free_ = next;
+  }
+  Link *tail = other.slabs_;
+  while (tail->next_ != nullptr) tail = tail->next_;
+  tail->next_ = slabs_;
+  slabs_ = other.slabs_;
+  other.slabs_ = nullptr;
+  other.cursor_ = nullptr;
+  other.limit_ = nullptr;
+}
+
+// Первые kAlign байт блока занимает ссылка на предыдущий блок.
+inline void SlabArena::grow_() {
+  char *slab =
+      static_cast<char *>(::operator new(kAlign + slab_cells_ * cell_size_));
+  Link *link = reinterpret_cast<Link *>(slab);
+  link->next_ = slabs_;
+  slabs_ = link;
+  cursor_ = slab + kAlign;
+  limit_ = cursor_ + slab_cells_ * cell_size_;
+  if (slab_cells_ < kMaxSlabCells) slab_cells_ *= 2;
+}
+
+// Аллокатор одиночных объектов поверх общей SlabArena. Копии и rebind-копии
+// разделяют арену и равны между собой; выделения по n > 1 элементов и
+// переразмеченные типы идут напрямую в operator new. Арена создается при
+// первом выделении или первом копировании, так что пустой контейнер не
+// обращается к куче.
+template <typename T>
+class SlabAllocator {
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  SlabAllocator() noexcept = default;
+  SlabAllocator(const SlabAllocator &other) : arena_(other.arena_ptr_()) {}
+  template <typename U>
+  SlabAllocator(const SlabAllocator<U> &other)
+      : arena_(other.arena_ptr_()) {}
+  SlabAllocator(SlabAllocator &&other) noexcept = default;
+  SlabAllocator &operator=(const SlabAllocator &other) {
+    arena_ = other.arena_ptr_();
+    return *this;
+  }
+  SlabAllocator &operator=(SlabAllocator &&other) noexcept = default;
+  ~SlabAllocator() = default;
+
+  T *allocate(size_type n);
+  void deallocate(T *ptr, size_type n) noexcept;
+
+  // Новый контейнер-копия получает собственную арену.
+  SlabAllocator select_on_container_copy_construction() const {
+    return SlabAllocator();
+  }
+
+  bool can_release() const noexcept { return arena_.use_count() <= 1; }
+  void release() noexcept {
+    if (arena_ != nullptr) arena_->release();
+  }
+  // Takes over other's slabs; without an arena of its own, takes other's.
+  template <typename U>
+  void adopt(SlabAllocator<U> &other) noexcept {
+    if (other.arena_ == nullptr || arena_ == other.arena_) return;
+    if (arena_ == nullptr) {
+      arena_ = std::move(other.arena_);
+    } else {
+      arena_->adopt(*other.arena_);
+    }
+  }
+
+  // Allocators without an arena yet are equal only to themselves.
+  template <typename U>
+  bool operator==(const SlabAllocator<U> &other) const noexcept {
+    if (arena_ == nullptr) {
+      return static_cast<const void *>(this) ==
+             static_cast<const void *>(&other);
+    }
+    return arena_ == other.arena_;
+  }
+  template <typename U>
+  bool operator!=(const SlabAllocator<U> &other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  template <typename U>
+  friend class SlabAllocator;
+
+  static constexpr bool kUsesArena = alignof(T) <= alignof(std::max_align_t);
+
+  // Копия пустого аллокатора должна делить с ним арену, поэтому арена
+  // заводится и у источника.
+  const std::shared_ptr<SlabArena> &arena_ptr_() const {
+    if (arena_ == nullptr) arena_ = std::make_shared<SlabArena>();
+    return arena_;
+  }
+
+  mutable std::shared_ptr<SlabArena> arena_;
+};
+
+template <typename T>
+T *SlabAllocator<T>::allocate(size_type n) {
+  if (n == 1 && kUsesArena) {
+    void *cell = arena_ptr_()->allocate(sizeof(T));
+    if (cell != nullptr) return static_cast<T *>(cell);
+  }
+  return static_cast<T *>(::operator new(n * sizeof(T)));
+}
+
+template <typename T>
+void SlabAllocator<T>::deallocate(T *ptr, size_type n) noexcept {
+  std::size_t cell = sizeof(T) < sizeof(void *) ? sizeof(void *) : sizeof(T);
+  if (n == 1 && kUsesArena && arena_ != nullptr &&
+      arena_->cell_size() == cell) {
+    arena_->deallocate(ptr);
+  } else {
+    ::operator delete(ptr);
+  }
+}
+
+// Аллокатор, умеющий разом вернуть всю память (см. SlabAllocator::release).
+template <typename A, typename = void>
+struct is_releasable_allocator : std::false_type {};
+
+template <typename A>
+struct is_releasable_allocator<
+    A, std::void_t<decltype(std::declval<const A &>().can_release()),
+                   decltype(std::declval<A &>().release())>>
+    : std::true_type {};
+
+}  // namespace s21
+
+#endif
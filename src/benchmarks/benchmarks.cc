@@ -0,0 +1,3 @@
+#include "benchmarks.h"
+
+BENCHMARK_MAIN();
@@ -0,0 +1,17 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+#endif
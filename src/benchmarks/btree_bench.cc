@@ -0,0 +1,73 @@
+#include "benchmarks.h"
+
+namespace {
+
+// Ключи вставляются вразброс: шаг 7919 взаимно прост с count.
+template <typename SetType>
+SetType ShuffledSet(int64_t count) {
+  SetType set;
+  int64_t key = 0;
+  for (int64_t i = 0; i < count; ++i) {
+    set.insert(key * 2);
+    key = (key + 7919) % count;
+  }
+  return set;
+}
+
+template <typename SetType>
+void BM_BTree_Build(benchmark::State &state) {
+  for (auto _ : state) {
+    SetType set = ShuffledSet<SetType>(state.range(0));
+    benchmark::DoNotOptimize(set.size());
+  }
+}
+BENCHMARK_TEMPLATE(BM_BTree_Build, s21::Set<int64_t>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BTree_Build, s21::BTreeSet<int64_t>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 1000000)
+    ->Unit(benchmark::kMillisecond);
+
+template <typename SetType>
+void BM_BTree_Contains(benchmark::State &state) {
+  const int64_t count = state.range(0);
+  SetType set = ShuffledSet<SetType>(count);
+  int64_t key = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(set.contains(key));
+    key = (key + 7919) % (4 * count);
+  }
+}
+BENCHMARK_TEMPLATE(BM_BTree_Contains, s21::Set<int64_t>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_BTree_Contains, s21::BTreeSet<int64_t>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 1000000);
+
+template <typename MapType>
+void BM_BTree_Scan(benchmark::State &state) {
+  const int64_t count = state.range(0);
+  MapType map;
+  int64_t key = 0;
+  for (int64_t i = 0; i < count; ++i) {
+    map.insert(key, i);
+    key = (key + 7919) % count;
+  }
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto it = map.begin(); it != map.end(); ++it) sum += it->second;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_BTree_Scan, s21::Map<int64_t, int64_t>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_BTree_Scan, s21::BTreeMap<int64_t, int64_t>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 1000000);
+
+}  // namespace
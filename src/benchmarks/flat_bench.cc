@@ -0,0 +1,72 @@
+#include "benchmarks.h"
+
+namespace {
+
+std::vector<std::pair<int, int>> ShuffledPairs(int count) {
+  std::vector<std::pair<int, int>> items;
+  int key = 0;
+  for (int i = 0; i < count; ++i) {
+    items.push_back({key, i});
+    key = (key + 7919) % count;
+  }
+  return items;
+}
+
+template <typename MapType>
+void BM_Flat_Find(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  std::vector<std::pair<int, int>> items = ShuffledPairs(count);
+  MapType map;
+  for (const auto &item : items) map.insert(item.first, item.second);
+  int key = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.at(key));
+    key = (key + 7919) % count;
+  }
+}
+BENCHMARK_TEMPLATE(BM_Flat_Find, s21::Map<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000);
+BENCHMARK_TEMPLATE(BM_Flat_Find, s21::BTreeMap<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000);
+BENCHMARK_TEMPLATE(BM_Flat_Find, s21::FlatMap<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000);
+
+// Построение из неупорядоченной пачки: дерево вставляет по одному, FlatMap
+// дописывает все и сортирует один раз.
+template <typename MapType>
+void BM_Flat_Build(benchmark::State &state) {
+  std::vector<std::pair<int, int>> items =
+      ShuffledPairs(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    MapType map(items.begin(), items.end());
+    benchmark::DoNotOptimize(map.size());
+  }
+}
+BENCHMARK_TEMPLATE(BM_Flat_Build, s21::BTreeMap<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000);
+BENCHMARK_TEMPLATE(BM_Flat_Build, s21::FlatMap<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(100, 100000);
+
+template <typename MapType>
+void BM_Flat_Scan(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  std::vector<std::pair<int, int>> items = ShuffledPairs(count);
+  MapType map;
+  for (const auto &item : items) map.insert(item.first, item.second);
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (auto it = map.begin(); it != map.end(); ++it) sum += it->second;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_Flat_Scan, s21::Map<int, int>)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_Flat_Scan, s21::BTreeMap<int, int>)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_Flat_Scan, s21::FlatMap<int, int>)->Arg(10000);
+
+}  // namespace
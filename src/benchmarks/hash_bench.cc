@@ -0,0 +1,85 @@
+#include <unordered_map>
+
+#include "benchmarks.h"
+
+namespace {
+
+std::vector<int> ScatteredKeys(int count) {
+  std::mt19937 gen(17);
+  std::vector<int> keys(count);
+  for (int &key : keys) key = static_cast<int>(gen() >> 1);
+  return keys;
+}
+
+template <typename MapType>
+void BM_Hash_Insert(benchmark::State &state) {
+  std::vector<int> keys = ScatteredKeys(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    MapType map;
+    for (int key : keys) map.insert({key, key});
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK_TEMPLATE(BM_Hash_Insert, s21::Map<int, int>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Hash_Insert, std::unordered_map<int, int>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Hash_Insert, s21::UnorderedMap<int, int>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 1000000);
+
+// Ключи длиннее SSO-буфера: при перестройке копия ключа стоила бы
+// выделения памяти, перемещение - только переноса указателя.
+template <typename MapType>
+void BM_Hash_InsertString(benchmark::State &state) {
+  std::vector<int> keys = ScatteredKeys(static_cast<int>(state.range(0)));
+  std::vector<std::string> names;
+  names.reserve(keys.size());
+  for (int key : keys) {
+    names.push_back(std::string(24, 'k') + std::to_string(key));
+  }
+  for (auto _ : state) {
+    MapType map;
+    for (const std::string &name : names) map.try_emplace(name, 0);
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK_TEMPLATE(BM_Hash_InsertString, std::unordered_map<std::string, int>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Hash_InsertString, s21::UnorderedMap<std::string, int>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 100000);
+
+// Попадания и промахи поровну: нечетные ключи в таблицу не попадают.
+template <typename MapType>
+void BM_Hash_Find(benchmark::State &state) {
+  std::vector<int> keys = ScatteredKeys(static_cast<int>(state.range(0)));
+  MapType map;
+  for (int &key : keys) {
+    key &= ~1;
+    map.insert({key, key});
+  }
+  size_t i = 0;
+  int64_t hits = 0;
+  for (auto _ : state) {
+    hits += map.find(keys[i] | (i & 1)) != map.end();
+    if (++i == keys.size()) i = 0;
+  }
+  benchmark::DoNotOptimize(hits);
+}
+BENCHMARK_TEMPLATE(BM_Hash_Find, s21::Map<int, int>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Hash_Find, std::unordered_map<int, int>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Hash_Find, s21::UnorderedMap<int, int>)
+    ->RangeMultiplier(100)
+    ->Range(1000, 1000000);
+
+}  // namespace
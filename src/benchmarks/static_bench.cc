@@ -0,0 +1,49 @@
+#include "benchmarks.h"
+
+namespace {
+
+// Половина запросов промахивается; ключи идут вразброс, как в BM_Set_Contains.
+template <typename SetType>
+void BM_Contains(benchmark::State &state) {
+  const int64_t count = state.range(0);
+  s21::Set<int64_t> set;
+  for (int64_t key = 0; key < count; ++key) set.insert(key * 2);
+  SetType lookup(set);
+
+  int64_t key = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lookup.contains(key));
+    key = (key + 7919) % (2 * count);
+  }
+  state.SetComplexityN(count);
+}
+BENCHMARK_TEMPLATE(BM_Contains, s21::Set<int64_t>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000)
+    ->Complexity(benchmark::oLogN);
+BENCHMARK_TEMPLATE(BM_Contains, s21::StaticSet<int64_t>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000)
+    ->Complexity(benchmark::oLogN);
+
+template <typename MapType>
+void BM_Find(benchmark::State &state) {
+  const int64_t count = state.range(0);
+  s21::Map<int64_t, int64_t> map;
+  for (int64_t key = 0; key < count; ++key) map.insert(key, key);
+  MapType lookup(map);
+
+  int64_t key = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lookup.at(key));
+    key = (key + 7919) % count;
+  }
+}
+BENCHMARK_TEMPLATE(BM_Find, s21::Map<int64_t, int64_t>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000);
+BENCHMARK_TEMPLATE(BM_Find, s21::StaticMap<int64_t, int64_t>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000);
+
+}  // namespace
@@ -0,0 +1,403 @@
+#include "benchmarks.h"
+
+namespace {
+
+std::vector<int> ShuffledKeys(int count) {
+  std::vector<int> keys(count);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(21));
+  return keys;
+}
+
+void BM_Map_Find(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(count);
+  s21::Map<int, int> map;
+  for (int key : keys) map.insert(key, key);
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.at(keys[i]));
+    if (++i == keys.size()) i = 0;
+  }
+  state.SetComplexityN(count);
+}
+BENCHMARK(BM_Map_Find)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000)
+    ->Complexity(benchmark::oLogN);
+
+void BM_Set_Contains(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(count);
+  s21::Set<int> set;
+  for (int key : keys) set.insert(key);
+
+  int key = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(set.contains(key));
+    key = (key + 7919) % (2 * count);
+  }
+  state.SetComplexityN(count);
+}
+BENCHMARK(BM_Set_Contains)
+    ->RangeMultiplier(10)
+    ->Range(1000, 10000000)
+    ->Complexity(benchmark::oLogN);
+
+// Окно из 100 соседних ключей: две границы и проход между ними.
+void BM_Map_RangeQuery(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(count);
+  s21::Map<int, int> map;
+  for (int key : keys) map.insert(key, key);
+
+  size_t i = 0;
+  for (auto _ : state) {
+    int from = keys[i];
+    long sum = 0;
+    auto last = map.upper_bound(from + 99);
+    for (auto it = map.lower_bound(from); it != last; ++it) sum += it->second;
+    benchmark::DoNotOptimize(sum);
+    if (++i == keys.size()) i = 0;
+  }
+  state.SetComplexityN(count);
+}
+BENCHMARK(BM_Map_RangeQuery)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Complexity(benchmark::oLogN);
+
+void BM_Multiset_Count(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  s21::Multiset<int> multiset;
+  for (int key : ShuffledKeys(count)) multiset.insert(key % 1000);
+
+  int key = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(multiset.count(key));
+    key = (key + 7) % 1000;
+  }
+  state.SetComplexityN(count);
+}
+BENCHMARK(BM_Multiset_Count)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Complexity(benchmark::oN);
+
+using RankedMultiset =
+    s21::Multiset<int, std::less<>, s21::SlabAllocator<int>,
+                  s21::OrderStatistics>;
+
+// p50 и p99: без размеров поддеревьев до k-го элемента приходится идти
+// итератором, с OrderStatistics хватает одного спуска.
+template <typename MultisetType>
+void BM_Multiset_Percentile(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  MultisetType multiset;
+  for (int key : ShuffledKeys(count)) multiset.insert(key % 1000);
+
+  for (auto _ : state) {
+    for (size_t k : {multiset.size() / 2, multiset.size() * 99 / 100}) {
+      if constexpr (std::is_same_v<MultisetType, RankedMultiset>) {
+        benchmark::DoNotOptimize(*multiset.select(k));
+      } else {
+        auto it = multiset.begin();
+        for (size_t i = 0; i < k; ++i) ++it;
+        benchmark::DoNotOptimize(*it);
+      }
+    }
+  }
+  state.SetComplexityN(count);
+}
+BENCHMARK_TEMPLATE(BM_Multiset_Percentile, s21::Multiset<int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Complexity(benchmark::oN);
+BENCHMARK_TEMPLATE(BM_Multiset_Percentile, RankedMultiset)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Complexity(benchmark::oLogN);
+
+void BM_Map_Iterate(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(count);
+  s21::Map<int, int> map;
+  for (int key : keys) map.insert(key, key);
+
+  for (auto _ : state) {
+    long sum = 0;
+    for (auto it = map.begin(); it != map.end(); ++it) sum += it->second;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.SetComplexityN(count);
+}
+BENCHMARK(BM_Map_Iterate)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Complexity(benchmark::oN);
+
+template <typename MapType>
+void BM_Map_BuildDestroy(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(count);
+
+  for (auto _ : state) {
+    MapType map;
+    for (int key : keys) map.insert(key, key);
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_Map_BuildDestroy, s21::Map<int, int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000);
+void BM_Map_InsertSorted(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    s21::Map<int, int> map;
+    for (int key = 0; key < count; ++key) map.insert(key, key);
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Map_InsertSorted)->RangeMultiplier(10)->Range(1000, 1000000);
+
+void BM_Map_AssignSorted(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  std::vector<std::pair<const int, int>> items;
+  for (int key = 0; key < count; ++key) items.emplace_back(key, key);
+
+  for (auto _ : state) {
+    s21::Map<int, int> map(items.begin(), items.end());
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.SetComplexityN(count);
+}
+BENCHMARK(BM_Map_AssignSorted)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Complexity(benchmark::oN);
+
+void BM_Map_CopyConstruct(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  s21::Map<int, int> source;
+  for (int key : ShuffledKeys(count)) source.insert(key, key);
+
+  for (auto _ : state) {
+    s21::Map<int, int> copy(source);
+    benchmark::DoNotOptimize(copy.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.SetComplexityN(count);
+}
+BENCHMARK(BM_Map_CopyConstruct)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Complexity(benchmark::oN);
+
+void BM_Map_CopyAssign(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  s21::Map<int, int> source;
+  for (int key : ShuffledKeys(count)) source.insert(key, key);
+  s21::Map<int, int> target(source);
+
+  for (auto _ : state) {
+    target = source;
+    benchmark::DoNotOptimize(target.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.SetComplexityN(count);
+}
+BENCHMARK(BM_Map_CopyAssign)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Complexity(benchmark::oN);
+
+void BM_Map_Merge(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(count);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    s21::Map<int, int> target;
+    s21::Map<int, int> source;
+    for (int i = 0; i < count; ++i) {
+      (i % 2 == 0 ? target : source).insert(keys[i], i);
+    }
+    state.ResumeTiming();
+    target.merge(source);
+    benchmark::DoNotOptimize(target.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count / 2);
+}
+BENCHMARK(BM_Map_Merge)->RangeMultiplier(10)->Range(1000, 1000000);
+
+void BM_Set_Union(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(count);
+  s21::Set<int> a;
+  s21::Set<int> b;
+  for (int i = 0; i < count; ++i) {
+    (i % 2 == 0 ? a : b).insert(keys[i] / 2 * 3);
+  }
+
+  for (auto _ : state) {
+    s21::Set<int> result = s21::set_union(a, b);
+    benchmark::DoNotOptimize(result.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.SetComplexityN(count);
+}
+BENCHMARK(BM_Set_Union)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000)
+    ->Complexity(benchmark::oN);
+
+// Разрушающие операции через split/join на 1..N потоках: range(0) - размер
+// каждого множества, range(1) - число потоков.
+using SetTree = s21::Tree<int, void, std::less<>, s21::SlabAllocator<int>>;
+
+template <void (SetTree::*Operation)(SetTree &, unsigned)>
+void BM_Set_JoinOperation(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  const unsigned threads = static_cast<unsigned>(state.range(1));
+  std::vector<int> keys = ShuffledKeys(2 * count);
+  s21::Set<int> a_source;
+  s21::Set<int> b_source;
+  for (int i = 0; i < count; ++i) {
+    a_source.insert(keys[i]);
+    b_source.insert(keys[count + i] / 2 * 2);
+  }
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    s21::Set<int> a(a_source);
+    s21::Set<int> b(a.get_allocator());
+    for (int key : b_source) b.insert(key);
+    state.ResumeTiming();
+    (a.*Operation)(b, threads);
+    benchmark::DoNotOptimize(a.size());
+  }
+  state.SetItemsProcessed(state.iterations() * count * 2);
+}
+
+void JoinOperationArgs(benchmark::internal::Benchmark *bench) {
+  unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  for (int count : {100000, 1000000}) {
+    for (unsigned threads = 1; threads < cores; threads *= 2) {
+      bench->Args({count, static_cast<int>(threads)});
+    }
+    bench->Args({count, static_cast<int>(cores)});
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Set_JoinOperation, &s21::Set<int>::union_with)
+    ->Apply(JoinOperationArgs)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Set_JoinOperation, &s21::Set<int>::intersect_with)
+    ->Apply(JoinOperationArgs)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Set_JoinOperation, &s21::Set<int>::difference_with)
+    ->Apply(JoinOperationArgs)
+    ->UseRealTime();
+
+using StdAllocMap =
+    s21::Map<int, int, std::less<>, std::allocator<std::pair<const int, int>>>;
+BENCHMARK_TEMPLATE(BM_Map_BuildDestroy, StdAllocMap)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000);
+
+// Цена поддержки размеров поддеревьев при вставке и удалении.
+using RankedMap =
+    s21::Map<int, int, std::less<>,
+             s21::SlabAllocator<std::pair<const int, int>>,
+             s21::OrderStatistics>;
+BENCHMARK_TEMPLATE(BM_Map_BuildDestroy, RankedMap)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000);
+
+// Ключи с общим префиксом: каждое сравнение проходит его целиком.
+std::vector<std::string> StringKeys(int count) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (int key : ShuffledKeys(count)) {
+    keys.push_back("/usr/share/containers/" + std::to_string(key));
+  }
+  return keys;
+}
+
+// Компаратор без прозрачности и без трехстороннего сравнения строк.
+struct PlainStringLess {
+  bool operator()(const std::string &a, const std::string &b) const {
+    return a < b;
+  }
+};
+
+template <typename Comp>
+void BM_Map_StringInsert(benchmark::State &state) {
+  std::vector<std::string> keys = StringKeys(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    s21::Map<std::string, int, Comp> map;
+    for (const std::string &key : keys) map.insert(key, 0);
+    benchmark::DoNotOptimize(map.size());
+  }
+}
+BENCHMARK_TEMPLATE(BM_Map_StringInsert, PlainStringLess)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Map_StringInsert, std::less<>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000);
+
+// Поиск по std::string_view: с прозрачным компаратором ключ не копируется
+// во временную std::string.
+void BM_Map_StringViewFind(benchmark::State &state) {
+  std::vector<std::string> keys = StringKeys(static_cast<int>(state.range(0)));
+  s21::Map<std::string, int> map;
+  for (const std::string &key : keys) map.insert(key, 0);
+  std::vector<std::string_view> views(keys.begin(), keys.end());
+
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(views[i]));
+    if (++i == views.size()) i = 0;
+  }
+}
+BENCHMARK(BM_Map_StringViewFind)->RangeMultiplier(10)->Range(1000, 100000);
+
+// Узел множества хранит ключ один раз: одна строка на элемент вместо двух.
+void BM_Set_StringBuild(benchmark::State &state) {
+  std::vector<std::string> keys = StringKeys(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    s21::Set<std::string> set;
+    for (const std::string &key : keys) set.insert(key);
+    benchmark::DoNotOptimize(set.size());
+  }
+}
+BENCHMARK(BM_Set_StringBuild)->RangeMultiplier(10)->Range(1000, 100000);
+
+// Много повторов при малом числе различных ключей (коды ответов, enum):
+// CountedMultiset держит по узлу на ключ вместо узла на копию.
+template <typename MultisetType>
+void BM_Multiset_Repetitive(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  std::vector<int> keys = ShuffledKeys(count);
+  for (int &key : keys) key %= 16;
+  for (auto _ : state) {
+    MultisetType multiset;
+    for (int key : keys) multiset.insert(key);
+    benchmark::DoNotOptimize(multiset.count(7));
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_Multiset_Repetitive, s21::Multiset<int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000);
+BENCHMARK_TEMPLATE(BM_Multiset_Repetitive, s21::CountedMultiset<int>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 1000000);
+
+}  // namespace
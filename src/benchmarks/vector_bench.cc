@@ -0,0 +1,155 @@
+#include "benchmarks.h"
+
+namespace {
+
+template <typename VectorType>
+void BM_Vector_PushBackInt(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    VectorType v;
+    for (int i = 0; i < count; ++i) v.push_back(i);
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_Vector_PushBackInt, std::vector<int>)
+    ->RangeMultiplier(100)
+    ->Range(100, 1000000);
+BENCHMARK_TEMPLATE(BM_Vector_PushBackInt, s21::Vector<int>)
+    ->RangeMultiplier(100)
+    ->Range(100, 1000000);
+
+// Строки длиннее SSO-буфера: при росте копирование означало бы выделение
+// памяти на каждый элемент, перемещение - только перенос указателя.
+template <typename VectorType>
+void BM_Vector_PushBackString(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  const std::string item(40, 'x');
+  for (auto _ : state) {
+    VectorType v;
+    for (int i = 0; i < count; ++i) v.push_back(item);
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_Vector_PushBackString, std::vector<std::string>)
+    ->RangeMultiplier(100)
+    ->Range(100, 1000000);
+BENCHMARK_TEMPLATE(BM_Vector_PushBackString, s21::Vector<std::string>)
+    ->RangeMultiplier(100)
+    ->Range(100, 1000000);
+
+// Вставка пачки из 64 элементов в середину: хвост сдвигается один раз на
+// всю пачку, а не по элементу.
+template <typename VectorType>
+void BM_Vector_InsertRangeMiddle(benchmark::State &state) {
+  using Item = typename VectorType::value_type;
+  const int count = static_cast<int>(state.range(0));
+  std::vector<Item> batch(64);
+  for (auto _ : state) {
+    state.PauseTiming();
+    VectorType v;
+    for (int i = 0; i < count; ++i) v.push_back(Item());
+    state.ResumeTiming();
+    for (int i = 0; i < 16; ++i) {
+      v.insert(v.begin() + v.size() / 2, batch.begin(), batch.end());
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+}
+BENCHMARK_TEMPLATE(BM_Vector_InsertRangeMiddle, std::vector<int>)
+    ->RangeMultiplier(100)
+    ->Range(100, 1000000);
+BENCHMARK_TEMPLATE(BM_Vector_InsertRangeMiddle, s21::Vector<int>)
+    ->RangeMultiplier(100)
+    ->Range(100, 1000000);
+BENCHMARK_TEMPLATE(BM_Vector_InsertRangeMiddle, std::vector<std::string>)
+    ->Arg(10000);
+BENCHMARK_TEMPLATE(BM_Vector_InsertRangeMiddle, s21::Vector<std::string>)
+    ->Arg(10000);
+
+// Удаление каждого третьего элемента: цикл из erase против erase_if.
+template <typename Item, bool kEraseIf>
+void BM_Vector_Filter(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    s21::Vector<Item> v;
+    for (int i = 0; i < count; ++i) v.push_back(Item());
+    state.ResumeTiming();
+    if constexpr (kEraseIf) {
+      int i = 0;
+      s21::erase_if(v, [&i](const Item &) { return i++ % 3 == 0; });
+    } else {
+      int i = 0;
+      for (auto it = v.begin(); it != v.end();) {
+        if (i++ % 3 == 0) {
+          v.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(v.data());
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_Vector_Filter, int, false)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Vector_Filter, int, true)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Vector_Filter, std::string, false)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000);
+BENCHMARK_TEMPLATE(BM_Vector_Filter, std::string, true)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000);
+
+// Та же обертка над unique_ptr, но без пометки is_trivially_relocatable:
+// показывает, сколько стоит перенос перемещением с разрушением.
+struct OwnedInt {
+  explicit OwnedInt(int v) : ptr(std::make_unique<int>(v)) {}
+  std::unique_ptr<int> ptr;
+};
+
+template <typename Item>
+Item MakeItem(int i) {
+  if constexpr (std::is_same_v<Item, std::unique_ptr<int>>) {
+    return std::make_unique<int>(i);
+  } else if constexpr (std::is_same_v<Item, std::string>) {
+    return std::string(40, static_cast<char>('a' + i % 26));
+  } else {
+    return Item(i);
+  }
+}
+
+// Рост и вставки в середину двигают все элементы; для тривиально
+// перемещаемых это memcpy/memmove.
+template <typename Item>
+void BM_Vector_Relocate(benchmark::State &state) {
+  const int count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    s21::Vector<Item> v;
+    for (int i = 0; i < count; ++i) v.push_back(MakeItem<Item>(i));
+    state.ResumeTiming();
+    for (int i = 0; i < 3; ++i) v.reserve(v.capacity() * 2);
+    for (int i = 0; i < 64; ++i) {
+      v.insert(v.begin() + v.size() / 2, MakeItem<Item>(i));
+      v.erase(v.begin() + v.size() / 3);
+    }
+    state.PauseTiming();
+    v.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_TEMPLATE(BM_Vector_Relocate, OwnedInt)->Arg(10000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Vector_Relocate, std::unique_ptr<int>)
+    ->Arg(10000)
+    ->Arg(100000);
+BENCHMARK_TEMPLATE(BM_Vector_Relocate, std::string)->Arg(10000)->Arg(100000);
+
+}  // namespace
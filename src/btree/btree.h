@@ -0,0 +1,874 @@
+#ifndef S21_BTREE_H
+#define S21_BTREE_H
+
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "../tree/tree.h"
+#include "../vector/vector.h"
+
+namespace s21 {
+
+// B-дерево: в узле до kMaxValues значений подряд, у внутреннего узла еще и
+// kMaxValues + 1 потомков. Узел занимает около NodeBytes байт, так что поиск
+// и обход читают несколько кэш-линий на узел вместо линии на элемент.
+// Раскладка значения - как у Tree: V = void дает множество.
+template <typename K, typename V, typename Comp = std::less<>,
+          typename Alloc = std::allocator<std::remove_const_t<
+              typename TreeValueTraits<K, V>::value_type>>,
+          std::size_t NodeBytes = 256>
+class BTree {
+ public:
+  using key_type = K;
+  using mapped_type = typename TreeValueTraits<K, V>::mapped_type;
+  using value_type = typename TreeValueTraits<K, V>::value_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Comp;
+  using allocator_type = Alloc;
+
+ protected:
+  using value_traits = TreeValueTraits<K, V>;
+  using slot_type = std::remove_const_t<value_type>;
+
+  struct Node;
+  struct InternalNode;
+
+ public:
+  // Values per node: NodeBytes / sizeof(value_type), but at least 3.
+  static constexpr size_type kMaxValues =
+      NodeBytes / sizeof(slot_type) < 3 ? 3 : NodeBytes / sizeof(slot_type);
+  static constexpr size_type kMinValues = kMaxValues / 2;
+  static_assert(kMaxValues <= std::numeric_limits<unsigned short>::max(),
+                "NodeBytes is too large");
+
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = const Iterator;
+
+  BTree() = default;
+  explicit BTree(const allocator_type &alloc) : alloc_(alloc) {}
+  explicit BTree(const key_compare &comp,
+                 const allocator_type &alloc = allocator_type())
+      : comp_(comp), alloc_(alloc) {}
+  BTree(const BTree &other);
+  BTree(BTree &&other) noexcept;
+  ~BTree() { clear(); }
+
+  BTree &operator=(const BTree &other);
+  BTree &operator=(BTree &&other) noexcept;
+
+  iterator begin() const noexcept;
+  iterator end() const noexcept;
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept;
+  allocator_type get_allocator() const { return alloc_; }
+  key_compare key_comp() const { return comp_; }
+
+  void clear() noexcept;
+  void swap(BTree &other) noexcept;
+  void erase(iterator pos);
+  void merge(BTree &other);
+
+  iterator find(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  iterator find(const Key &key) const;
+  bool contains(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  bool contains(const Key &key) const;
+
+  // Lookups binary-search each node on the way down: O(log n) comparisons
+  // and O(log n / log kMaxValues) nodes.
+  iterator lower_bound(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  iterator lower_bound(const Key &key) const;
+  iterator upper_bound(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  iterator upper_bound(const Key &key) const;
+  std::pair<iterator, iterator> equal_range(const key_type &key) const;
+  size_type count(const key_type &key) const;
+
+  // Узел и номер значения в нем; end() - пустой узел.
+  class Iterator {
+   public:
+    Iterator(Node *node, size_type index, const BTree &tree) noexcept
+        : node_(node), index_(index), tree_(&tree) {}
+
+    bool operator==(const Iterator &other) const {
+      return node_ == other.node_ && index_ == other.index_;
+    }
+    bool operator!=(const Iterator &other) const { return !(*this == other); }
+    const key_type &operator*() const {
+      return value_traits::key(*node_->slot(index_));
+    }
+    value_type *operator->() const { return node_->slot(index_); }
+
+    Iterator &operator++() noexcept;
+    Iterator operator++(int) noexcept;
+    Iterator &operator--() noexcept;
+    Iterator operator--(int) noexcept;
+
+   private:
+    friend class BTree;
+
+    Node *node_;
+    size_type index_;
+    const BTree *tree_;
+  };
+
+ protected:
+  struct Node {
+    Node *parent_ = nullptr;
+    unsigned short position_ = 0;  // номер в children_ родителя
+    unsigned short count_ = 0;
+    bool leaf_ = true;
+    alignas(slot_type) unsigned char values_[kMaxValues * sizeof(slot_type)];
+
+    slot_type *slot(size_type i) noexcept {
+      return std::launder(reinterpret_cast<slot_type *>(values_) + i);
+    }
+    const key_type &key(size_type i) noexcept {
+      return value_traits::key(*slot(i));
+    }
+  };
+  struct InternalNode : Node {
+    Node *children_[kMaxValues + 1];
+  };
+
+  using leaf_allocator_type =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using internal_allocator_type = typename std::allocator_traits<
+      Alloc>::template rebind_alloc<InternalNode>;
+
+  static Node *&child_(Node *node, size_type i) noexcept {
+    return static_cast<InternalNode *>(node)->children_[i];
+  }
+  static void set_child_(Node *node, size_type i, Node *child) noexcept;
+  static void prefetch_(Node *node) noexcept;
+  // Перенос значения в неинициализированную ячейку: у пары с const ключом
+  // нет присваивания, поэтому сдвиги идут через конструирование.
+  static void transfer_(slot_type *to, slot_type *from);
+  static void shift_right_(Node *node, size_type from);
+  static void shift_left_(Node *node, size_type from);
+  static void shift_children_right_(Node *node, size_type from);
+  static void shift_children_left_(Node *node, size_type from);
+
+  Node *new_node_(bool leaf);
+  void delete_node_(Node *node) noexcept;
+  void destroy_(Node *node) noexcept;
+  Node *clone_(Node *src);
+
+  template <typename Key>
+  size_type lower_index_(Node *node, const Key &key) const;
+  template <typename Key>
+  size_type upper_index_(Node *node, const Key &key) const;
+  template <typename Key>
+  iterator find_pos_(const Key &key) const;
+  template <typename Key>
+  bool contains_(const Key &key) const;
+  template <typename Key>
+  iterator lower_bound_(const Key &key) const;
+  template <typename Key>
+  iterator upper_bound_(const Key &key) const;
+
+  // Вставка, если ключа еще нет; args строят значение узла.
+  template <typename Key, typename... Args>
+  std::pair<iterator, bool> insert_unique_(const Key &key, Args &&...args);
+  void split_(Node *node, size_type middle);
+  void rebalance_(Node *node);
+  void rotate_right_(Node *parent, size_type i);
+  void rotate_left_(Node *parent, size_type i);
+  void merge_children_(Node *parent, size_type i);
+
+ private:
+  Node *root_ = nullptr;
+  Node *leftmost_ = nullptr;
+  Node *rightmost_ = nullptr;
+  size_type size_ = 0;
+  key_compare comp_;
+  allocator_type alloc_;
+};
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+BTree<K, V, Comp, Alloc, NodeBytes>::BTree(const BTree &other)
+    : comp_(other.comp_),
+      alloc_(std::allocator_traits<Alloc>::
+                 select_on_container_copy_construction(other.alloc_)) {
+  if (other.root_ == nullptr) return;
+  root_ = clone_(other.root_);
+  leftmost_ = root_;
+  while (!leftmost_->leaf_) leftmost_ = child_(leftmost_, 0);
+  rightmost_ = root_;
+  while (!rightmost_->leaf_) {
+    rightmost_ = child_(rightmost_, rightmost_->count_);
+  }
+  size_ = other.size_;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+BTree<K, V, Comp, Alloc, NodeBytes>::BTree(BTree &&other) noexcept
+    : root_(other.root_),
+      leftmost_(other.leftmost_),
+      rightmost_(other.rightmost_),
+      size_(other.size_),
+      comp_(other.comp_),
+      alloc_(other.alloc_) {
+  other.root_ = other.leftmost_ = other.rightmost_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+BTree<K, V, Comp, Alloc, NodeBytes> &
+BTree<K, V, Comp, Alloc, NodeBytes>::operator=(const BTree &other) {
+  if (this != &other) {
+    BTree copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+BTree<K, V, Comp, Alloc, NodeBytes> &
+BTree<K, V, Comp, Alloc, NodeBytes>::operator=(BTree &&other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator
+BTree<K, V, Comp, Alloc, NodeBytes>::begin() const noexcept {
+  return iterator(leftmost_, 0, *this);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator
+BTree<K, V, Comp, Alloc, NodeBytes>::end() const noexcept {
+  return iterator(nullptr, 0, *this);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::size_type
+BTree<K, V, Comp, Alloc, NodeBytes>::max_size() const noexcept {
+  return std::numeric_limits<size_type>::max() / sizeof(slot_type) / 2;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::clear() noexcept {
+  if (root_ != nullptr) destroy_(root_);
+  root_ = leftmost_ = rightmost_ = nullptr;
+  size_ = 0;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::swap(BTree &other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(leftmost_, other.leftmost_);
+  std::swap(rightmost_, other.rightmost_);
+  std::swap(size_, other.size_);
+  std::swap(comp_, other.comp_);
+  std::swap(alloc_, other.alloc_);
+}
+
+// Значение во внутреннем узле заменяется предшественником из листа, так
+// что удаление всегда идет из листа; затем недобор чинится снизу вверх.
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::erase(iterator pos) {
+  Node *node = pos.node_;
+  size_type index = pos.index_;
+  if (node == nullptr) return;
+  if (node->leaf_) {
+    node->slot(index)->~slot_type();
+    shift_left_(node, index + 1);
+  } else {
+    Node *leaf = child_(node, index);
+    while (!leaf->leaf_) leaf = child_(leaf, leaf->count_);
+    node->slot(index)->~slot_type();
+    transfer_(node->slot(index), leaf->slot(leaf->count_ - 1));
+    node = leaf;
+  }
+  --node->count_;
+  --size_;
+  rebalance_(node);
+}
+
+// Значения, чьих ключей здесь нет, переносятся; остальные остаются в other.
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::merge(BTree &other) {
+  if (this == &other) return;
+  BTree rest(other.comp_, other.alloc_);
+  for (iterator it = other.begin(); it != other.end(); ++it) {
+    slot_type *value = it.node_->slot(it.index_);
+    if (!insert_unique_(*it, std::move(*value)).second) {
+      rest.insert_unique_(*it, std::move(*value));
+    }
+  }
+  other.swap(rest);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator
+BTree<K, V, Comp, Alloc, NodeBytes>::find(const key_type &key) const {
+  return find_pos_(key);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <typename Key, typename>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator
+BTree<K, V, Comp, Alloc, NodeBytes>::find(const Key &key) const {
+  return find_pos_(key);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline bool BTree<K, V, Comp, Alloc, NodeBytes>::contains(
+    const key_type &key) const {
+  return contains_(key);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <typename Key, typename>
+inline bool BTree<K, V, Comp, Alloc, NodeBytes>::contains(
+    const Key &key) const {
+  return contains_(key);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator
+BTree<K, V, Comp, Alloc, NodeBytes>::lower_bound(const key_type &key) const {
+  return lower_bound_(key);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <typename Key, typename>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator
+BTree<K, V, Comp, Alloc, NodeBytes>::lower_bound(const Key &key) const {
+  return lower_bound_(key);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator
+BTree<K, V, Comp, Alloc, NodeBytes>::upper_bound(const key_type &key) const {
+  return upper_bound_(key);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <typename Key, typename>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator
+BTree<K, V, Comp, Alloc, NodeBytes>::upper_bound(const Key &key) const {
+  return upper_bound_(key);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+std::pair<typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator,
+          typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator>
+BTree<K, V, Comp, Alloc, NodeBytes>::equal_range(const key_type &key) const {
+  iterator first = find_pos_(key);
+  if (first == end()) return {lower_bound_(key), lower_bound_(key)};
+  iterator last = first;
+  return {first, ++last};
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::size_type
+BTree<K, V, Comp, Alloc, NodeBytes>::count(const key_type &key) const {
+  return contains_(key) ? 1 : 0;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+typename BTree<K, V, Comp, Alloc, NodeBytes>::Iterator &
+BTree<K, V, Comp, Alloc, NodeBytes>::Iterator::operator++() noexcept {
+  if (!node_->leaf_) {
+    node_ = child_(node_, index_ + 1);
+    while (!node_->leaf_) node_ = child_(node_, 0);
+    index_ = 0;
+    return *this;
+  }
+  if (++index_ < node_->count_) return *this;
+  while (node_->parent_ != nullptr) {
+    index_ = node_->position_;
+    node_ = node_->parent_;
+    if (index_ < node_->count_) return *this;
+  }
+  node_ = nullptr;
+  index_ = 0;
+  return *this;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::Iterator
+BTree<K, V, Comp, Alloc, NodeBytes>::Iterator::operator++(int) noexcept {
+  Iterator tmp(*this);
+  ++*this;
+  return tmp;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+typename BTree<K, V, Comp, Alloc, NodeBytes>::Iterator &
+BTree<K, V, Comp, Alloc, NodeBytes>::Iterator::operator--() noexcept {
+  if (node_ == nullptr) {
+    node_ = tree_->rightmost_;
+    index_ = node_->count_ - 1;
+    return *this;
+  }
+  if (!node_->leaf_) {
+    node_ = child_(node_, index_);
+    while (!node_->leaf_) node_ = child_(node_, node_->count_);
+    index_ = node_->count_ - 1;
+    return *this;
+  }
+  while (index_ == 0 && node_->parent_ != nullptr) {
+    index_ = node_->position_;
+    node_ = node_->parent_;
+  }
+  --index_;
+  return *this;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::Iterator
+BTree<K, V, Comp, Alloc, NodeBytes>::Iterator::operator--(int) noexcept {
+  Iterator tmp(*this);
+  --*this;
+  return tmp;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline void BTree<K, V, Comp, Alloc, NodeBytes>::set_child_(
+    Node *node, size_type i, Node *child) noexcept {
+  child_(node, i) = child;
+  child->parent_ = node;
+  child->position_ = static_cast<unsigned short>(i);
+}
+
+// Бинарный поиск прыгает по всему узлу: все его линии запрашиваются сразу,
+// чтобы промахи шли параллельно, а не по одному на шаг.
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline void BTree<K, V, Comp, Alloc, NodeBytes>::prefetch_(
+    Node *node) noexcept {
+  const char *bytes = reinterpret_cast<const char *>(node);
+  for (size_type offset = 64; offset < sizeof(Node); offset += 64) {
+    __builtin_prefetch(bytes + offset);
+  }
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline void BTree<K, V, Comp, Alloc, NodeBytes>::transfer_(slot_type *to,
+                                                           slot_type *from) {
+  ::new (static_cast<void *>(to)) slot_type(std::move(*from));
+  from->~slot_type();
+}
+
+// Освобождает ячейку from, сдвигая значения [from, count_) вправо.
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::shift_right_(Node *node,
+                                                       size_type from) {
+  for (size_type i = node->count_; i > from; --i) {
+    transfer_(node->slot(i), node->slot(i - 1));
+  }
+}
+
+// Закрывает пустую ячейку from - 1, сдвигая [from, count_) влево.
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::shift_left_(Node *node,
+                                                      size_type from) {
+  for (size_type i = from; i < node->count_; ++i) {
+    transfer_(node->slot(i - 1), node->slot(i));
+  }
+}
+
+// То же для потомков [from, count_]; счетчик узла меняет вызывающий.
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::shift_children_right_(
+    Node *node, size_type from) {
+  for (size_type i = node->count_ + 1; i > from; --i) {
+    set_child_(node, i, child_(node, i - 1));
+  }
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::shift_children_left_(
+    Node *node, size_type from) {
+  for (size_type i = from; i <= node->count_; ++i) {
+    set_child_(node, i - 1, child_(node, i));
+  }
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+typename BTree<K, V, Comp, Alloc, NodeBytes>::Node *
+BTree<K, V, Comp, Alloc, NodeBytes>::new_node_(bool leaf) {
+  Node *node;
+  if (leaf) {
+    leaf_allocator_type alloc(alloc_);
+    node = ::new (static_cast<void *>(
+        std::allocator_traits<leaf_allocator_type>::allocate(alloc, 1))) Node;
+  } else {
+    internal_allocator_type alloc(alloc_);
+    node = ::new (static_cast<void *>(
+        std::allocator_traits<internal_allocator_type>::allocate(alloc, 1)))
+        InternalNode;
+  }
+  node->leaf_ = leaf;
+  return node;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::delete_node_(Node *node) noexcept {
+  if (node->leaf_) {
+    leaf_allocator_type alloc(alloc_);
+    std::allocator_traits<leaf_allocator_type>::deallocate(alloc, node, 1);
+  } else {
+    internal_allocator_type alloc(alloc_);
+    std::allocator_traits<internal_allocator_type>::deallocate(
+        alloc, static_cast<InternalNode *>(node), 1);
+  }
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::destroy_(Node *node) noexcept {
+  if (!node->leaf_) {
+    for (size_type i = 0; i <= node->count_; ++i) destroy_(child_(node, i));
+  }
+  if constexpr (!std::is_trivially_destructible_v<slot_type>) {
+    for (size_type i = 0; i < node->count_; ++i) node->slot(i)->~slot_type();
+  }
+  delete_node_(node);
+}
+
+// При исключении частично скопированный узел разбирается: count_ - число
+// построенных значений, потомки строятся после них.
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+typename BTree<K, V, Comp, Alloc, NodeBytes>::Node *
+BTree<K, V, Comp, Alloc, NodeBytes>::clone_(Node *src) {
+  Node *node = new_node_(src->leaf_);
+  size_type children = 0;
+  try {
+    for (; node->count_ < src->count_; ++node->count_) {
+      ::new (static_cast<void *>(node->slot(node->count_)))
+          slot_type(*src->slot(node->count_));
+    }
+    if (!src->leaf_) {
+      for (; children <= src->count_; ++children) {
+        set_child_(node, children, clone_(child_(src, children)));
+      }
+    }
+  } catch (...) {
+    for (size_type i = 0; i < children; ++i) destroy_(child_(node, i));
+    for (size_type i = 0; i < node->count_; ++i) node->slot(i)->~slot_type();
+    delete_node_(node);
+    throw;
+  }
+  return node;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <typename Key>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::size_type
+BTree<K, V, Comp, Alloc, NodeBytes>::lower_index_(Node *node,
+                                                  const Key &key) const {
+  prefetch_(node);
+  size_type first = 0;
+  size_type length = node->count_;
+  while (length > 1) {
+    size_type half = length / 2;
+    first = comp_(node->key(first + half), key) ? first + half : first;
+    length -= half;
+  }
+  return first + (length == 1 && comp_(node->key(first), key));
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <typename Key>
+inline typename BTree<K, V, Comp, Alloc, NodeBytes>::size_type
+BTree<K, V, Comp, Alloc, NodeBytes>::upper_index_(Node *node,
+                                                  const Key &key) const {
+  prefetch_(node);
+  size_type first = 0;
+  size_type length = node->count_;
+  while (length > 1) {
+    size_type half = length / 2;
+    first = comp_(key, node->key(first + half)) ? first : first + half;
+    length -= half;
+  }
+  return first + (length == 1 && !comp_(key, node->key(first)));
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <typename Key>
+typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator
+BTree<K, V, Comp, Alloc, NodeBytes>::find_pos_(const Key &key) const {
+  for (Node *node = root_; node != nullptr;) {
+    size_type i = lower_index_(node, key);
+    if (i < node->count_ && !comp_(key, node->key(i))) {
+      return iterator(node, i, *this);
+    }
+    node = node->leaf_ ? nullptr : child_(node, i);
+  }
+  return end();
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <typename Key>
+inline bool BTree<K, V, Comp, Alloc, NodeBytes>::contains_(
+    const Key &key) const {
+  return find_pos_(key) != end();
+}
+
+// Кандидат - последний узел спуска, где нашлось значение не меньше ключа.
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <typename Key>
+typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator
+BTree<K, V, Comp, Alloc, NodeBytes>::lower_bound_(const Key &key) const {
+  iterator result = end();
+  for (Node *node = root_; node != nullptr;) {
+    size_type i = lower_index_(node, key);
+    if (i < node->count_) result = iterator(node, i, *this);
+    node = node->leaf_ ? nullptr : child_(node, i);
+  }
+  return result;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <typename Key>
+typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator
+BTree<K, V, Comp, Alloc, NodeBytes>::upper_bound_(const Key &key) const {
+  iterator result = end();
+  for (Node *node = root_; node != nullptr;) {
+    size_type i = upper_index_(node, key);
+    if (i < node->count_) result = iterator(node, i, *this);
+    node = node->leaf_ ? nullptr : child_(node, i);
+  }
+  return result;
+}
+
+// Значение строится до изменения дерева, так что исключение в конструкторе
+// его не портит; новый ключ всегда попадает в лист. Ключ больше максимума
+// дописывается в rightmost_ без спуска, а полный правый лист при этом
+// делится не пополам, а с новым листом под хвост: отсортированный ввод
+// дает почти полные листья.
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <typename Key, typename... Args>
+std::pair<typename BTree<K, V, Comp, Alloc, NodeBytes>::iterator, bool>
+BTree<K, V, Comp, Alloc, NodeBytes>::insert_unique_(const Key &key,
+                                                    Args &&...args) {
+  Node *node = root_;
+  size_type index = 0;
+  if (node != nullptr &&
+      comp_(rightmost_->key(rightmost_->count_ - 1), key)) {
+    node = rightmost_;
+    index = node->count_;
+  } else {
+    while (node != nullptr) {
+      index = lower_index_(node, key);
+      if (index < node->count_ && !comp_(key, node->key(index))) {
+        return {iterator(node, index, *this), false};
+      }
+      if (node->leaf_) break;
+      node = child_(node, index);
+    }
+  }
+  slot_type value(std::forward<Args>(args)...);
+  if (node == nullptr) {
+    node = root_ = leftmost_ = rightmost_ = new_node_(true);
+  } else if (node->count_ == kMaxValues) {
+    size_type middle = node == rightmost_ && index == node->count_
+                           ? kMaxValues - 1
+                           : kMaxValues / 2;
+    split_(node, middle);
+    if (index > middle) {
+      index -= middle + 1;
+      node = child_(node->parent_, node->position_ + 1);
+    }
+  }
+  shift_right_(node, index);
+  ::new (static_cast<void *>(node->slot(index))) slot_type(std::move(value));
+  ++node->count_;
+  ++size_;
+  return {iterator(node, index, *this), true};
+}
+
+// Значение middle полного узла уходит в родителя, хвост - в новый правый
+// сосед; полный родитель делится раньше пополам.
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::split_(Node *node,
+                                                 size_type middle) {
+  Node *sibling = new_node_(node->leaf_);
+  try {
+    if (node->parent_ == nullptr) {
+      Node *root = new_node_(false);
+      set_child_(root, 0, node);
+      root_ = root;
+    } else if (node->parent_->count_ == kMaxValues) {
+      split_(node->parent_, kMaxValues / 2);
+    }
+  } catch (...) {
+    delete_node_(sibling);
+    throw;
+  }
+  Node *parent = node->parent_;
+  size_type position = node->position_;
+  for (size_type i = middle + 1; i < node->count_; ++i) {
+    transfer_(sibling->slot(i - middle - 1), node->slot(i));
+  }
+  if (!node->leaf_) {
+    for (size_type i = middle + 1; i <= node->count_; ++i) {
+      set_child_(sibling, i - middle - 1, child_(node, i));
+    }
+  }
+  sibling->count_ = static_cast<unsigned short>(node->count_ - middle - 1);
+  shift_right_(parent, position);
+  shift_children_right_(parent, position + 1);
+  transfer_(parent->slot(position), node->slot(middle));
+  set_child_(parent, position + 1, sibling);
+  ++parent->count_;
+  node->count_ = static_cast<unsigned short>(middle);
+  if (node == rightmost_) rightmost_ = sibling;
+}
+
+// Недобор в узле закрывается значением соседа, если у того есть лишнее,
+// иначе узел сливается с соседом и недобор может подняться к родителю.
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::rebalance_(Node *node) {
+  while (node != root_ && node->count_ < kMinValues) {
+    Node *parent = node->parent_;
+    size_type position = node->position_;
+    if (position > 0 && child_(parent, position - 1)->count_ > kMinValues) {
+      rotate_right_(parent, position - 1);
+      return;
+    }
+    if (position < parent->count_ &&
+        child_(parent, position + 1)->count_ > kMinValues) {
+      rotate_left_(parent, position);
+      return;
+    }
+    merge_children_(parent, position > 0 ? position - 1 : position);
+    node = parent;
+  }
+  if (root_->count_ == 0) {
+    Node *old_root = root_;
+    if (root_->leaf_) {
+      root_ = leftmost_ = rightmost_ = nullptr;
+    } else {
+      root_ = child_(root_, 0);
+      root_->parent_ = nullptr;
+      root_->position_ = 0;
+    }
+    delete_node_(old_root);
+  }
+}
+
+// Последнее значение левого потомка поднимается в родителя, а разделитель
+// опускается в начало правого.
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::rotate_right_(Node *parent,
+                                                        size_type i) {
+  Node *left = child_(parent, i);
+  Node *right = child_(parent, i + 1);
+  shift_right_(right, 0);
+  if (!right->leaf_) shift_children_right_(right, 0);
+  transfer_(right->slot(0), parent->slot(i));
+  transfer_(parent->slot(i), left->slot(left->count_ - 1));
+  if (!right->leaf_) set_child_(right, 0, child_(left, left->count_));
+  --left->count_;
+  ++right->count_;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::rotate_left_(Node *parent,
+                                                       size_type i) {
+  Node *left = child_(parent, i);
+  Node *right = child_(parent, i + 1);
+  transfer_(left->slot(left->count_), parent->slot(i));
+  transfer_(parent->slot(i), right->slot(0));
+  if (!left->leaf_) {
+    set_child_(left, left->count_ + 1, child_(right, 0));
+    shift_children_left_(right, 1);
+  }
+  shift_left_(right, 1);
+  ++left->count_;
+  --right->count_;
+}
+
+// Правый потомок и разделитель дописываются в левого, правый удаляется.
+template <typename K, typename V, typename Comp, typename Alloc,
+          size_t NodeBytes>
+void BTree<K, V, Comp, Alloc, NodeBytes>::merge_children_(Node *parent,
+                                                          size_type i) {
+  Node *left = child_(parent, i);
+  Node *right = child_(parent, i + 1);
+  size_type offset = left->count_ + 1;
+  transfer_(left->slot(left->count_), parent->slot(i));
+  for (size_type j = 0; j < right->count_; ++j) {
+    transfer_(left->slot(offset + j), right->slot(j));
+  }
+  if (!left->leaf_) {
+    for (size_type j = 0; j <= right->count_; ++j) {
+      set_child_(left, offset + j, child_(right, j));
+    }
+  }
+  left->count_ = static_cast<unsigned short>(offset + right->count_);
+  shift_left_(parent, i + 1);
+  shift_children_left_(parent, i + 2);
+  --parent->count_;
+  if (right == rightmost_) rightmost_ = left;
+  right->count_ = 0;
+  delete_node_(right);
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,221 @@
+#ifndef S21_BTREE_MAP_H
+#define S21_BTREE_MAP_H
+
+#include <tuple>
+#include <utility>
+
+#include "../btree/btree.h"
+
+namespace s21 {
+
+// Drop-in replacement for Map when the index is large: values live in
+// B-tree nodes of about NodeBytes bytes, so a lookup touches a few nodes
+// instead of one node per level and a scan walks values stored next to
+// each other. There are no node handles; any insert or erase may move
+// values between nodes and invalidates iterators.
+template <typename K, typename T, typename Comp = std::less<>,
+          typename Alloc = std::allocator<std::pair<const K, T>>,
+          std::size_t NodeBytes = 256>
+class BTreeMap : public BTree<K, T, Comp, Alloc, NodeBytes> {
+ public:
+  using key_type = K;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename BTree<K, T, Comp, Alloc, NodeBytes>::iterator;
+  using const_iterator =
+      typename BTree<K, T, Comp, Alloc, NodeBytes>::const_iterator;
+  using size_type = size_t;
+  using key_compare = Comp;
+  using allocator_type = Alloc;
+
+  BTreeMap() = default;
+  explicit BTreeMap(const allocator_type &alloc)
+      : BTree<K, T, Comp, Alloc, NodeBytes>(alloc) {}
+  explicit BTreeMap(const key_compare &comp,
+                    const allocator_type &alloc = allocator_type())
+      : BTree<K, T, Comp, Alloc, NodeBytes>(comp, alloc) {}
+  BTreeMap(std::initializer_list<value_type> const &items);
+  template <class InputIt, class = EnableIfIterator<InputIt>>
+  BTreeMap(InputIt first, InputIt last);
+
+  mapped_type &at(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  mapped_type &at(const Key &key) const;
+  mapped_type &operator[](const key_type &key);
+  mapped_type &operator[](key_type &&key);
+
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  std::pair<iterator, bool> insert(const key_type &key, const T &obj);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, const T &obj);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, T &&obj);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args);
+
+  template <class... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+};
+
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+BTreeMap<K, T, Comp, Alloc, NodeBytes>::BTreeMap(
+    std::initializer_list<value_type> const &items) {
+  for (const value_type &item : items) insert(item);
+}
+
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <class InputIt, class>
+BTreeMap<K, T, Comp, Alloc, NodeBytes>::BTreeMap(InputIt first,
+                                                 InputIt last) {
+  for (; first != last; ++first) insert(*first);
+}
+
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+T &BTreeMap<K, T, Comp, Alloc, NodeBytes>::at(const key_type &key) const {
+  iterator it = BTree<K, T, Comp, Alloc, NodeBytes>::find_pos_(key);
+  if (it == BTree<K, T, Comp, Alloc, NodeBytes>::end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <typename Key, typename>
+T &BTreeMap<K, T, Comp, Alloc, NodeBytes>::at(const Key &key) const {
+  iterator it = BTree<K, T, Comp, Alloc, NodeBytes>::find_pos_(key);
+  if (it == BTree<K, T, Comp, Alloc, NodeBytes>::end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline T &BTreeMap<K, T, Comp, Alloc, NodeBytes>::operator[](
+    const key_type &key) {
+  return try_emplace(key).first->second;
+}
+
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline T &BTreeMap<K, T, Comp, Alloc, NodeBytes>::operator[](
+    key_type &&key) {
+  return try_emplace(std::move(key)).first->second;
+}
+
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline std::pair<typename BTreeMap<K, T, Comp, Alloc, NodeBytes>::iterator,
+                 bool>
+BTreeMap<K, T, Comp, Alloc, NodeBytes>::insert(const value_type &value) {
+  return BTree<K, T, Comp, Alloc, NodeBytes>::insert_unique_(value.first,
+                                                             value);
+}
+
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline std::pair<typename BTreeMap<K, T, Comp, Alloc, NodeBytes>::iterator,
+                 bool>
+BTreeMap<K, T, Comp, Alloc, NodeBytes>::insert(value_type &&value) {
+  return BTree<K, T, Comp, Alloc, NodeBytes>::insert_unique_(
+      value.first, std::move(value));
+}
+
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+inline std::pair<typename BTreeMap<K, T, Comp, Alloc, NodeBytes>::iterator,
+                 bool>
+BTreeMap<K, T, Comp, Alloc, NodeBytes>::insert(const key_type &key,
+                                               const T &obj) {
+  return BTree<K, T, Comp, Alloc, NodeBytes>::insert_unique_(key, key, obj);
+}
+
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+std::pair<typename BTreeMap<K, T, Comp, Alloc, NodeBytes>::iterator, bool>
+BTreeMap<K, T, Comp, Alloc, NodeBytes>::insert_or_assign(const key_type &key,
+                                                         const T &obj) {
+  std::pair<iterator, bool> result = try_emplace(key, obj);
+  if (!result.second) {
+    result.first->second = obj;
+  }
+  return result;
+}
+
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+std::pair<typename BTreeMap<K, T, Comp, Alloc, NodeBytes>::iterator, bool>
+BTreeMap<K, T, Comp, Alloc, NodeBytes>::insert_or_assign(const key_type &key,
+                                                         T &&obj) {
+  std::pair<iterator, bool> result = try_emplace(key, std::move(obj));
+  if (!result.second) {
+    result.first->second = std::move(obj);
+  }
+  return result;
+}
+
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <class... Args>
+inline std::pair<typename BTreeMap<K, T, Comp, Alloc, NodeBytes>::iterator,
+                 bool>
+BTreeMap<K, T, Comp, Alloc, NodeBytes>::emplace(Args &&...args) {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+// Значение строится только если ключа еще нет.
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <class... Args>
+inline std::pair<typename BTreeMap<K, T, Comp, Alloc, NodeBytes>::iterator,
+                 bool>
+BTreeMap<K, T, Comp, Alloc, NodeBytes>::try_emplace(const key_type &key,
+                                                    Args &&...args) {
+  return BTree<K, T, Comp, Alloc, NodeBytes>::insert_unique_(
+      key, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <class... Args>
+inline std::pair<typename BTreeMap<K, T, Comp, Alloc, NodeBytes>::iterator,
+                 bool>
+BTreeMap<K, T, Comp, Alloc, NodeBytes>::try_emplace(key_type &&key,
+                                                    Args &&...args) {
+  return BTree<K, T, Comp, Alloc, NodeBytes>::insert_unique_(
+      key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+// Вставка сдвигает значения соседей, поэтому итераторы собираются заново
+// после всех вставок.
+template <typename K, typename T, typename Comp, typename Alloc,
+          size_t NodeBytes>
+template <class... Args>
+Vector<std::pair<typename BTreeMap<K, T, Comp, Alloc, NodeBytes>::iterator,
+                 bool>>
+BTreeMap<K, T, Comp, Alloc, NodeBytes>::insert_many(Args &&...args) {
+  Vector<std::pair<iterator, bool>> ret;
+  for (auto arg : {args...}) {
+    ret.push_back(insert(arg));
+  }
+  size_type i = 0;
+  for (auto arg : {args...}) {
+    ret[i++].first = BTree<K, T, Comp, Alloc, NodeBytes>::find_pos_(arg.first);
+  }
+  return ret;
+}
+
+}  // namespace s21
+
+#endif
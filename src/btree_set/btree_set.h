@@ -0,0 +1,104 @@
+#ifndef S21_BTREE_SET_H
+#define S21_BTREE_SET_H
+
+#include <utility>
+
+#include "../btree/btree.h"
+
+namespace s21 {
+
+// Drop-in replacement for Set backed by a B-tree; see BTreeMap. Keys are
+// stored contiguously in each node, e.g. 64 ints per 256-byte node.
+template <typename Value, typename Comp = std::less<>,
+          typename Alloc = std::allocator<Value>, std::size_t NodeBytes = 256>
+class BTreeSet : public BTree<Value, void, Comp, Alloc, NodeBytes> {
+ public:
+  using key_type = Value;
+  using value_type = Value;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator =
+      typename BTree<Value, void, Comp, Alloc, NodeBytes>::iterator;
+  using const_iterator =
+      typename BTree<Value, void, Comp, Alloc, NodeBytes>::const_iterator;
+  using size_type = size_t;
+  using key_compare = Comp;
+  using allocator_type = Alloc;
+
+  BTreeSet() = default;
+  explicit BTreeSet(const allocator_type &alloc)
+      : BTree<Value, void, Comp, Alloc, NodeBytes>(alloc) {}
+  explicit BTreeSet(const key_compare &comp,
+                    const allocator_type &alloc = allocator_type())
+      : BTree<Value, void, Comp, Alloc, NodeBytes>(comp, alloc) {}
+  BTreeSet(std::initializer_list<value_type> const &items);
+  template <class InputIt, class = EnableIfIterator<InputIt>>
+  BTreeSet(InputIt first, InputIt last);
+
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+
+  template <class... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+};
+
+template <typename Value, typename Comp, typename Alloc, size_t NodeBytes>
+BTreeSet<Value, Comp, Alloc, NodeBytes>::BTreeSet(
+    std::initializer_list<value_type> const &items) {
+  for (const value_type &item : items) insert(item);
+}
+
+template <typename Value, typename Comp, typename Alloc, size_t NodeBytes>
+template <class InputIt, class>
+BTreeSet<Value, Comp, Alloc, NodeBytes>::BTreeSet(InputIt first,
+                                                  InputIt last) {
+  for (; first != last; ++first) insert(*first);
+}
+
+template <typename Value, typename Comp, typename Alloc, size_t NodeBytes>
+inline std::pair<typename BTreeSet<Value, Comp, Alloc, NodeBytes>::iterator,
+                 bool>
+BTreeSet<Value, Comp, Alloc, NodeBytes>::insert(const value_type &value) {
+  return BTree<Value, void, Comp, Alloc, NodeBytes>::insert_unique_(value,
+                                                                    value);
+}
+
+template <typename Value, typename Comp, typename Alloc, size_t NodeBytes>
+inline std::pair<typename BTreeSet<Value, Comp, Alloc, NodeBytes>::iterator,
+                 bool>
+BTreeSet<Value, Comp, Alloc, NodeBytes>::insert(value_type &&value) {
+  return BTree<Value, void, Comp, Alloc, NodeBytes>::insert_unique_(
+      value, std::move(value));
+}
+
+template <typename Value, typename Comp, typename Alloc, size_t NodeBytes>
+template <class... Args>
+inline std::pair<typename BTreeSet<Value, Comp, Alloc, NodeBytes>::iterator,
+                 bool>
+BTreeSet<Value, Comp, Alloc, NodeBytes>::emplace(Args &&...args) {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+// Итераторы собираются после всех вставок, как в BTreeMap::insert_many.
+template <typename Value, typename Comp, typename Alloc, size_t NodeBytes>
+template <class... Args>
+Vector<std::pair<typename BTreeSet<Value, Comp, Alloc, NodeBytes>::iterator,
+                 bool>>
+BTreeSet<Value, Comp, Alloc, NodeBytes>::insert_many(Args &&...args) {
+  Vector<std::pair<iterator, bool>> ret;
+  for (auto arg : {args...}) {
+    ret.push_back(insert(arg));
+  }
+  size_type i = 0;
+  for (auto arg : {args...}) {
+    ret[i++].first =
+        BTree<Value, void, Comp, Alloc, NodeBytes>::find_pos_(arg);
+  }
+  return ret;
+}
+
+}  // namespace s21
+
+#endif
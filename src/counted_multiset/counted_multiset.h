@@ -0,0 +1,374 @@
+#ifndef S21_COUNTED_MULTISET_H
+#define S21_COUNTED_MULTISET_H
+
+#include "../tree/tree.h"
+#include "../vector/vector.h"
+
+namespace s21 {
+
+// Мультимножество со счетчиками: каждому различному ключу соответствует
+// один узел, в котором хранится число его копий. Память и высота дерева
+// зависят только от числа различных ключей, а итератор по-прежнему
+// проходит каждую копию.
+template <typename Key, typename Comp = std::less<>,
+          typename Alloc = SlabAllocator<std::pair<const Key, std::size_t>>>
+class CountedMultiset : private Tree<Key, std::size_t, Comp, Alloc> {
+  using Base = Tree<Key, std::size_t, Comp, Alloc>;
+  using NodeIterator = typename Base::iterator;
+
+ public:
+  using key_type = Key;
+  using value_type = key_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using key_compare = Comp;
+  using allocator_type = Alloc;
+
+  // Узел дерева и номер копии ключа в нем; end() - заголовок и копия 0.
+  class Iterator {
+   public:
+    Iterator(NodeIterator node, size_type copy) noexcept
+        : node_(node), copy_(copy) {}
+
+    bool operator==(const Iterator &other) {
+      return node_ == other.node_ && copy_ == other.copy_;
+    }
+    bool operator!=(const Iterator &other) { return !(*this == other); }
+    key_type operator*() { return *node_; }
+    const key_type *operator->() { return &node_->first; }
+
+    Iterator &operator++();
+    Iterator operator++(int);
+    Iterator &operator--();
+    Iterator operator--(int);
+
+   private:
+    friend class CountedMultiset;
+
+    NodeIterator node_;
+    size_type copy_;
+  };
+
+  using iterator = Iterator;
+  using const_iterator = const Iterator;
+
+  CountedMultiset() = default;
+  explicit CountedMultiset(const allocator_type &alloc);
+  explicit CountedMultiset(const key_compare &comp,
+                           const allocator_type &alloc = allocator_type());
+  CountedMultiset(std::initializer_list<value_type> const &items);
+  template <class InputIt, class = EnableIfIterator<InputIt>>
+  CountedMultiset(InputIt first, InputIt last);
+  CountedMultiset(const CountedMultiset &other);
+  CountedMultiset(CountedMultiset &&other) noexcept;
+  ~CountedMultiset() = default;
+  CountedMultiset &operator=(const CountedMultiset &other);
+  CountedMultiset &operator=(CountedMultiset &&other) noexcept;
+
+  iterator begin();
+  iterator end();
+
+  bool empty() const noexcept;          // checks whether there are no copies
+  size_type size() const noexcept;      // returns the number of copies
+  size_type max_size() const noexcept;  // returns the maximum number of keys
+  size_type distinct_size() const noexcept;  // returns the number of keys
+
+  void clear();  // clears the contents
+  // Insertion and erasure of a copy are O(log d) for d distinct keys. The
+  // returned iterator points to the first inserted copy.
+  iterator insert(const value_type &value);
+  iterator insert(value_type &&value);
+  iterator insert(const value_type &value, size_type copies);
+  template <class... Args>
+  iterator emplace(Args &&...args);
+  void erase(iterator pos);              // erases the copy at pos
+  size_type erase(const key_type &key);  // erases every copy of key
+  void swap(CountedMultiset &other);
+  void merge(CountedMultiset &other);  // adds other's counts, empties other
+
+  size_type count(const key_type &key);  // O(log d): the count is stored
+  iterator find(const key_type &key);    // finds the first copy of key
+  bool contains(const key_type &key);
+  // Returns the first and the last copy of key, or end() twice, as in
+  // Multiset.
+  std::pair<iterator, iterator> equal_range(const key_type &key);
+  iterator lower_bound(const key_type &key);
+  iterator upper_bound(const key_type &key);
+
+  template <class... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+
+ private:
+  template <typename Value>
+  iterator add_(Value &&value, size_type copies);
+
+  size_type size_ = 0;
+};
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::Iterator &
+CountedMultiset<Key, Comp, Alloc>::Iterator::operator++() {
+  if (++copy_ == node_->second) {
+    ++node_;
+    copy_ = 0;
+  }
+  return *this;
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::Iterator
+CountedMultiset<Key, Comp, Alloc>::Iterator::operator++(int) {
+  Iterator tmp(*this);
+  ++*this;
+  return tmp;
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::Iterator &
+CountedMultiset<Key, Comp, Alloc>::Iterator::operator--() {
+  if (copy_ == 0) {
+    --node_;
+    copy_ = node_->second - 1;
+  } else {
+    --copy_;
+  }
+  return *this;
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::Iterator
+CountedMultiset<Key, Comp, Alloc>::Iterator::operator--(int) {
+  Iterator tmp(*this);
+  --*this;
+  return tmp;
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline CountedMultiset<Key, Comp, Alloc>::CountedMultiset(
+    const allocator_type &alloc)
+    : Base(alloc) {}
+
+template <typename Key, typename Comp, typename Alloc>
+inline CountedMultiset<Key, Comp, Alloc>::CountedMultiset(
+    const key_compare &comp, const allocator_type &alloc)
+    : Base(comp, alloc) {}
+
+template <typename Key, typename Comp, typename Alloc>
+inline CountedMultiset<Key, Comp, Alloc>::CountedMultiset(
+    std::initializer_list<value_type> const &items) {
+  for (const value_type &item : items) insert(item);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+template <class InputIt, class>
+inline CountedMultiset<Key, Comp, Alloc>::CountedMultiset(InputIt first,
+                                                          InputIt last) {
+  for (; first != last; ++first) insert(*first);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline CountedMultiset<Key, Comp, Alloc>::CountedMultiset(
+    const CountedMultiset &other)
+    : Base(other), size_(other.size_) {}
+
+template <typename Key, typename Comp, typename Alloc>
+inline CountedMultiset<Key, Comp, Alloc>::CountedMultiset(
+    CountedMultiset &&other) noexcept
+    : Base(std::move(other)), size_(other.size_) {
+  other.size_ = 0;
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline CountedMultiset<Key, Comp, Alloc> &
+CountedMultiset<Key, Comp, Alloc>::operator=(const CountedMultiset &other) {
+  Base::operator=(other);
+  size_ = other.size_;
+  return *this;
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline CountedMultiset<Key, Comp, Alloc> &
+CountedMultiset<Key, Comp, Alloc>::operator=(
+    CountedMultiset &&other) noexcept {
+  if (this != &other) {
+    Base::operator=(std::move(other));
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::iterator
+CountedMultiset<Key, Comp, Alloc>::begin() {
+  return iterator(Base::begin(), 0);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::iterator
+CountedMultiset<Key, Comp, Alloc>::end() {
+  return iterator(Base::end(), 0);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline bool CountedMultiset<Key, Comp, Alloc>::empty() const noexcept {
+  return size_ == 0;
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::size_type
+CountedMultiset<Key, Comp, Alloc>::size() const noexcept {
+  return size_;
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::size_type
+CountedMultiset<Key, Comp, Alloc>::max_size() const noexcept {
+  return Base::max_size();
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::size_type
+CountedMultiset<Key, Comp, Alloc>::distinct_size() const noexcept {
+  return Base::size();
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline void CountedMultiset<Key, Comp, Alloc>::clear() {
+  Base::clear();
+  size_ = 0;
+}
+
+// Узел создается со счетчиком 0 только для нового ключа, поэтому при
+// copies == 0 дерево не меняется.
+template <typename Key, typename Comp, typename Alloc>
+template <typename Value>
+typename CountedMultiset<Key, Comp, Alloc>::iterator
+CountedMultiset<Key, Comp, Alloc>::add_(Value &&value, size_type copies) {
+  if (copies == 0) return find(value);
+  NodeIterator node =
+      Base::try_emplace_(std::forward<Value>(value), size_type(0)).first;
+  size_type first_copy = node->second;
+  node->second += copies;
+  size_ += copies;
+  return iterator(node, first_copy);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::iterator
+CountedMultiset<Key, Comp, Alloc>::insert(const value_type &value) {
+  return add_(value, 1);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::iterator
+CountedMultiset<Key, Comp, Alloc>::insert(value_type &&value) {
+  return add_(std::move(value), 1);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::iterator
+CountedMultiset<Key, Comp, Alloc>::insert(const value_type &value,
+                                          size_type copies) {
+  return add_(value, copies);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+template <class... Args>
+inline typename CountedMultiset<Key, Comp, Alloc>::iterator
+CountedMultiset<Key, Comp, Alloc>::emplace(Args &&...args) {
+  return add_(value_type(std::forward<Args>(args)...), 1);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+void CountedMultiset<Key, Comp, Alloc>::erase(iterator pos) {
+  if (pos == end()) return;
+  if (--pos.node_->second == 0) Base::erase(pos.node_);
+  --size_;
+}
+
+template <typename Key, typename Comp, typename Alloc>
+typename CountedMultiset<Key, Comp, Alloc>::size_type
+CountedMultiset<Key, Comp, Alloc>::erase(const key_type &key) {
+  NodeIterator node = Base::find_pos_(key);
+  if (node == Base::end()) return 0;
+  size_type copies = node->second;
+  Base::erase(node);
+  size_ -= copies;
+  return copies;
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline void CountedMultiset<Key, Comp, Alloc>::swap(CountedMultiset &other) {
+  Base::swap(other);
+  std::swap(size_, other.size_);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+void CountedMultiset<Key, Comp, Alloc>::merge(CountedMultiset &other) {
+  if (this == &other) return;
+  if (empty()) {
+    swap(other);
+    return;
+  }
+  for (NodeIterator node = other.Base::begin(); node != other.Base::end();
+       ++node) {
+    add_(node->first, node->second);
+  }
+  other.clear();
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::size_type
+CountedMultiset<Key, Comp, Alloc>::count(const key_type &key) {
+  NodeIterator node = Base::find_pos_(key);
+  return node == Base::end() ? 0 : node->second;
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::iterator
+CountedMultiset<Key, Comp, Alloc>::find(const key_type &key) {
+  return iterator(Base::find_pos_(key), 0);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline bool CountedMultiset<Key, Comp, Alloc>::contains(const key_type &key) {
+  return Base::contains(key);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+std::pair<typename CountedMultiset<Key, Comp, Alloc>::iterator,
+          typename CountedMultiset<Key, Comp, Alloc>::iterator>
+CountedMultiset<Key, Comp, Alloc>::equal_range(const key_type &key) {
+  NodeIterator node = Base::find_pos_(key);
+  if (node == Base::end()) return {end(), end()};
+  return {iterator(node, 0), iterator(node, node->second - 1)};
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::iterator
+CountedMultiset<Key, Comp, Alloc>::lower_bound(const key_type &key) {
+  return iterator(Base::lower_bound(key), 0);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+inline typename CountedMultiset<Key, Comp, Alloc>::iterator
+CountedMultiset<Key, Comp, Alloc>::upper_bound(const key_type &key) {
+  return iterator(Base::upper_bound(key), 0);
+}
+
+template <typename Key, typename Comp, typename Alloc>
+template <class... Args>
+Vector<std::pair<typename CountedMultiset<Key, Comp, Alloc>::iterator, bool>>
+CountedMultiset<Key, Comp, Alloc>::insert_many(Args &&...args) {
+  Vector<std::pair<iterator, bool>> ret;
+  for (auto arg : {args...}) {
+    ret.push_back({insert(arg), true});
+  }
+  return ret;
+}
+
+}  // namespace s21
+
+#endif
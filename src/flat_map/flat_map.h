@@ -0,0 +1,189 @@
+#ifndef S21_FLAT_MAP_H
+#define S21_FLAT_MAP_H
+
+#include <utility>
+
+#include "../flat_tree/flat_tree.h"
+
+namespace s21 {
+
+// Map over two sorted parallel s21::Vectors, for small to medium maps that
+// are read far more often than written: lookups binary-search one dense
+// array of keys, but a single insert or erase shifts the tail. Prefer
+// insert_many for batches; it sorts and merges once. Any modification
+// invalidates iterators.
+template <typename K, typename T, typename Comp = std::less<>>
+class FlatMap : public FlatTree<K, T, Comp> {
+ public:
+  using key_type = K;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using iterator = typename FlatTree<K, T, Comp>::iterator;
+  using const_iterator = typename FlatTree<K, T, Comp>::const_iterator;
+  using size_type = size_t;
+  using key_compare = Comp;
+
+  FlatMap() = default;
+  explicit FlatMap(const key_compare &comp) : FlatTree<K, T, Comp>(comp) {}
+  FlatMap(std::initializer_list<value_type> const &items);
+  template <class InputIt, class = EnableIfIterator<InputIt>>
+  FlatMap(InputIt first, InputIt last);
+
+  mapped_type &at(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  mapped_type &at(const Key &key) const;
+  mapped_type &operator[](const key_type &key);
+  mapped_type &operator[](key_type &&key);
+
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  std::pair<iterator, bool> insert(const key_type &key, const T &obj);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, const T &obj);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, T &&obj);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args);
+
+  // Appends every pair, then sorts the batch and merges it with the map in
+  // one pass: O(n + k log k) instead of k shifts of the tail.
+  template <class... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+};
+
+template <typename K, typename T, typename Comp>
+FlatMap<K, T, Comp>::FlatMap(std::initializer_list<value_type> const &items) {
+  FlatTree<K, T, Comp>::reserve(items.size());
+  for (const value_type &item : items) {
+    FlatTree<K, T, Comp>::append_(item.first, item.second);
+  }
+  FlatTree<K, T, Comp>::insert_tail_(0);
+}
+
+template <typename K, typename T, typename Comp>
+template <class InputIt, class>
+FlatMap<K, T, Comp>::FlatMap(InputIt first, InputIt last) {
+  for (; first != last; ++first) {
+    FlatTree<K, T, Comp>::append_(first->first, first->second);
+  }
+  FlatTree<K, T, Comp>::insert_tail_(0);
+}
+
+template <typename K, typename T, typename Comp>
+T &FlatMap<K, T, Comp>::at(const key_type &key) const {
+  iterator it = FlatTree<K, T, Comp>::find_(key);
+  if (it == FlatTree<K, T, Comp>::end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename K, typename T, typename Comp>
+template <typename Key, typename>
+T &FlatMap<K, T, Comp>::at(const Key &key) const {
+  iterator it = FlatTree<K, T, Comp>::find_(key);
+  if (it == FlatTree<K, T, Comp>::end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename K, typename T, typename Comp>
+inline T &FlatMap<K, T, Comp>::operator[](const key_type &key) {
+  return try_emplace(key).first->second;
+}
+
+template <typename K, typename T, typename Comp>
+inline T &FlatMap<K, T, Comp>::operator[](key_type &&key) {
+  return try_emplace(std::move(key)).first->second;
+}
+
+template <typename K, typename T, typename Comp>
+inline std::pair<typename FlatMap<K, T, Comp>::iterator, bool>
+FlatMap<K, T, Comp>::insert(const value_type &value) {
+  return FlatTree<K, T, Comp>::insert_unique_(value.first, value.second);
+}
+
+// Ключ в value_type константный, поэтому переносится только значение.
+template <typename K, typename T, typename Comp>
+inline std::pair<typename FlatMap<K, T, Comp>::iterator, bool>
+FlatMap<K, T, Comp>::insert(value_type &&value) {
+  return FlatTree<K, T, Comp>::insert_unique_(value.first,
+                                              std::move(value.second));
+}
+
+template <typename K, typename T, typename Comp>
+inline std::pair<typename FlatMap<K, T, Comp>::iterator, bool>
+FlatMap<K, T, Comp>::insert(const key_type &key, const T &obj) {
+  return FlatTree<K, T, Comp>::insert_unique_(key, obj);
+}
+
+template <typename K, typename T, typename Comp>
+std::pair<typename FlatMap<K, T, Comp>::iterator, bool>
+FlatMap<K, T, Comp>::insert_or_assign(const key_type &key, const T &obj) {
+  std::pair<iterator, bool> result = try_emplace(key, obj);
+  if (!result.second) {
+    result.first->second = obj;
+  }
+  return result;
+}
+
+template <typename K, typename T, typename Comp>
+std::pair<typename FlatMap<K, T, Comp>::iterator, bool>
+FlatMap<K, T, Comp>::insert_or_assign(const key_type &key, T &&obj) {
+  std::pair<iterator, bool> result = try_emplace(key, std::move(obj));
+  if (!result.second) {
+    result.first->second = std::move(obj);
+  }
+  return result;
+}
+
+template <typename K, typename T, typename Comp>
+template <class... Args>
+inline std::pair<typename FlatMap<K, T, Comp>::iterator, bool>
+FlatMap<K, T, Comp>::emplace(Args &&...args) {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+template <typename K, typename T, typename Comp>
+template <class... Args>
+inline std::pair<typename FlatMap<K, T, Comp>::iterator, bool>
+FlatMap<K, T, Comp>::try_emplace(const key_type &key, Args &&...args) {
+  return FlatTree<K, T, Comp>::insert_unique_(key,
+                                              std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, typename Comp>
+template <class... Args>
+inline std::pair<typename FlatMap<K, T, Comp>::iterator, bool>
+FlatMap<K, T, Comp>::try_emplace(key_type &&key, Args &&...args) {
+  return FlatTree<K, T, Comp>::insert_unique_(std::move(key),
+                                              std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, typename Comp>
+template <class... Args>
+Vector<std::pair<typename FlatMap<K, T, Comp>::iterator, bool>>
+FlatMap<K, T, Comp>::insert_many(Args &&...args) {
+  std::initializer_list<value_type> items = {
+      value_type(std::forward<Args>(args))...};
+  size_type sorted = FlatTree<K, T, Comp>::size();
+  FlatTree<K, T, Comp>::reserve(sorted + items.size());
+  for (const value_type &item : items) {
+    FlatTree<K, T, Comp>::append_(item.first, item.second);
+  }
+  Vector<char> inserted = FlatTree<K, T, Comp>::insert_tail_(sorted);
+  Vector<std::pair<iterator, bool>> ret;
+  size_type i = 0;
+  for (const value_type &arg : items) {
+    ret.push_back({FlatTree<K, T, Comp>::find_(arg.first),
+                   inserted.begin()[i++] != 0});
+  }
+  return ret;
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef S21_FLAT_SET_H
+#define S21_FLAT_SET_H
+
+#include <utility>
+
+#include "../flat_tree/flat_tree.h"
+
+namespace s21 {
+
+// Set over one sorted s21::Vector of keys; see FlatMap.
+template <typename Value, typename Comp = std::less<>>
+class FlatSet : public FlatTree<Value, void, Comp> {
+ public:
+  using key_type = Value;
+  using value_type = Value;
+  using iterator = typename FlatTree<Value, void, Comp>::iterator;
+  using const_iterator = typename FlatTree<Value, void, Comp>::const_iterator;
+  using size_type = size_t;
+  using key_compare = Comp;
+
+  FlatSet() = default;
+  explicit FlatSet(const key_compare &comp)
+      : FlatTree<Value, void, Comp>(comp) {}
+  FlatSet(std::initializer_list<value_type> const &items);
+  template <class InputIt, class = EnableIfIterator<InputIt>>
+  FlatSet(InputIt first, InputIt last);
+
+  std::pair<iterator, bool> insert(const value_type &value);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+
+  // Appends every key, then sorts and merges once; see FlatMap.
+  template <class... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+};
+
+template <typename Value, typename Comp>
+FlatSet<Value, Comp>::FlatSet(std::initializer_list<value_type> const &items) {
+  FlatTree<Value, void, Comp>::reserve(items.size());
+  for (const value_type &item : items) {
+    FlatTree<Value, void, Comp>::append_(item);
+  }
+  FlatTree<Value, void, Comp>::insert_tail_(0);
+}
+
+template <typename Value, typename Comp>
+template <class InputIt, class>
+FlatSet<Value, Comp>::FlatSet(InputIt first, InputIt last) {
+  for (; first != last; ++first) FlatTree<Value, void, Comp>::append_(*first);
+  FlatTree<Value, void, Comp>::insert_tail_(0);
+}
+
+template <typename Value, typename Comp>
+inline std::pair<typename FlatSet<Value, Comp>::iterator, bool>
+FlatSet<Value, Comp>::insert(const value_type &value) {
+  return FlatTree<Value, void, Comp>::insert_unique_(value);
+}
+
+template <typename Value, typename Comp>
+template <class... Args>
+inline std::pair<typename FlatSet<Value, Comp>::iterator, bool>
+FlatSet<Value, Comp>::emplace(Args &&...args) {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+template <typename Value, typename Comp>
+template <class... Args>
+Vector<std::pair<typename FlatSet<Value, Comp>::iterator, bool>>
+FlatSet<Value, Comp>::insert_many(Args &&...args) {
+  std::initializer_list<value_type> items = {
+      value_type(std::forward<Args>(args))...};
+  size_type sorted = FlatTree<Value, void, Comp>::size();
+  FlatTree<Value, void, Comp>::reserve(sorted + items.size());
+  for (const value_type &item : items) {
+    FlatTree<Value, void, Comp>::append_(item);
+  }
+  Vector<char> inserted = FlatTree<Value, void, Comp>::insert_tail_(sorted);
+  Vector<std::pair<iterator, bool>> ret;
+  size_type i = 0;
+  for (const value_type &item : items) {
+    ret.push_back({FlatTree<Value, void, Comp>::find_(item),
+                   inserted.begin()[i++] != 0});
+  }
+  return ret;
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,419 @@
+#ifndef S21_FLAT_TREE_H
+#define S21_FLAT_TREE_H
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "../tree/tree.h"
+#include "../vector/vector.h"
+
+namespace s21 {
+
+// Итератор по параллельным массивам: ключ и значение с одним номером.
+template <typename K, typename V>
+class FlatIterator {
+ public:
+  // operator-> отдает пару ссылок, чтобы работали it->first и it->second.
+  class Pointer {
+   public:
+    explicit Pointer(std::pair<const K &, V &> pair) : pair_(pair) {}
+    std::pair<const K &, V &> *operator->() { return &pair_; }
+
+   private:
+    std::pair<const K &, V &> pair_;
+  };
+
+  FlatIterator(K *key, V *value) noexcept : key_(key), value_(value) {}
+
+  bool operator==(const FlatIterator &other) const {
+    return key_ == other.key_;
+  }
+  bool operator!=(const FlatIterator &other) const {
+    return key_ != other.key_;
+  }
+  const K &operator*() const { return *key_; }
+  Pointer operator->() const { return Pointer({*key_, *value_}); }
+
+  FlatIterator &operator++() noexcept {
+    ++key_;
+    ++value_;
+    return *this;
+  }
+  FlatIterator operator++(int) noexcept {
+    FlatIterator tmp(*this);
+    ++*this;
+    return tmp;
+  }
+  FlatIterator &operator--() noexcept {
+    --key_;
+    --value_;
+    return *this;
+  }
+  FlatIterator operator--(int) noexcept {
+    FlatIterator tmp(*this);
+    --*this;
+    return tmp;
+  }
+
+  const K *key() const noexcept { return key_; }
+
+ private:
+  K *key_;
+  V *value_;
+};
+
+template <typename K>
+class FlatIterator<K, void> {
+ public:
+  FlatIterator(K *key, void *) noexcept : key_(key) {}
+
+  bool operator==(const FlatIterator &other) const {
+    return key_ == other.key_;
+  }
+  bool operator!=(const FlatIterator &other) const {
+    return key_ != other.key_;
+  }
+  const K &operator*() const { return *key_; }
+  const K *operator->() const { return key_; }
+
+  FlatIterator &operator++() noexcept {
+    ++key_;
+    return *this;
+  }
+  FlatIterator operator++(int) noexcept { return FlatIterator(key_++, {}); }
+  FlatIterator &operator--() noexcept {
+    --key_;
+    return *this;
+  }
+  FlatIterator operator--(int) noexcept { return FlatIterator(key_--, {}); }
+
+  const K *key() const noexcept { return key_; }
+
+ private:
+  K *key_;
+};
+
+// Отсортированный массив ключей и параллельный массив значений (V = void -
+// множество без значений). Поиск - бинарный по плотному массиву, вставка и
+// удаление сдвигают хвост, так что контейнер рассчитан на небольшие и
+// редко меняющиеся данные; пачку ключей выгоднее вставлять через
+// insert_tail_, одной сортировкой и слиянием.
+template <typename K, typename V, typename Comp = std::less<>>
+class FlatTree {
+ public:
+  using key_type = K;
+  using mapped_type = typename TreeValueTraits<K, V>::mapped_type;
+  using size_type = size_t;
+  using key_compare = Comp;
+  using iterator = FlatIterator<K, V>;
+  using const_iterator = const FlatIterator<K, V>;
+
+  FlatTree() = default;
+  explicit FlatTree(const key_compare &comp) : comp_(comp) {}
+  FlatTree(const FlatTree &other);
+  FlatTree(FlatTree &&other) = default;
+  ~FlatTree() = default;
+
+  FlatTree &operator=(const FlatTree &other);
+  FlatTree &operator=(FlatTree &&other) = default;
+
+  iterator begin() const noexcept { return at_(0); }
+  iterator end() const noexcept { return at_(keys_.size()); }
+
+  bool empty() const noexcept { return keys_.empty(); }
+  size_type size() const noexcept { return keys_.size(); }
+  size_type max_size() const noexcept { return keys_.max_size(); }
+  size_type capacity() const noexcept { return keys_.capacity(); }
+  key_compare key_comp() const { return comp_; }
+
+  void reserve(size_type count);
+  void clear() noexcept;
+  void swap(FlatTree &other) noexcept;
+  void erase(iterator pos);
+  void merge(FlatTree &other);
+
+  iterator find(const key_type &key) const { return find_(key); }
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  iterator find(const Key &key) const {
+    return find_(key);
+  }
+  bool contains(const key_type &key) const { return find_(key) != end(); }
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  bool contains(const Key &key) const {
+    return find_(key) != end();
+  }
+  iterator lower_bound(const key_type &key) const {
+    return at_(lower_index_(key));
+  }
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  iterator lower_bound(const Key &key) const {
+    return at_(lower_index_(key));
+  }
+  iterator upper_bound(const key_type &key) const {
+    return at_(upper_index_(key));
+  }
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  iterator upper_bound(const Key &key) const {
+    return at_(upper_index_(key));
+  }
+  std::pair<iterator, iterator> equal_range(const key_type &key) const;
+  size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+ protected:
+  struct NoValues {};
+  using values_type =
+      std::conditional_t<std::is_void_v<V>, NoValues, Vector<V>>;
+  static constexpr bool kHasValues = !std::is_void_v<V>;
+
+  iterator at_(size_type index) const noexcept;
+  size_type index_(iterator pos) const noexcept {
+    return pos.key() - keys_.begin();
+  }
+  template <typename Key>
+  size_type lower_index_(const Key &key) const;
+  template <typename Key>
+  size_type upper_index_(const Key &key) const;
+  template <typename Key>
+  iterator find_(const Key &key) const;
+
+  // Вставка ключа (и значения из args), если его еще нет. Ключ вставляется
+  // первым и убирается, если значение построить не удалось.
+  template <typename Key, typename... Args>
+  std::pair<iterator, bool> insert_unique_(Key &&key, Args &&...args);
+  // Дописывает пару в конец без проверки порядка, для insert_tail_.
+  template <typename... Args>
+  void append_(const key_type &key, Args &&...args);
+  // Хвост [sorted, size()) сортируется и сливается с упорядоченной частью;
+  // повторы отбрасываются, побеждает первая вставка. Возвращает флаги
+  // "вставлен" для элементов хвоста в порядке их добавления.
+  Vector<char> insert_tail_(size_type sorted);
+
+ private:
+  void grow_();
+
+  Vector<K> keys_;
+  values_type values_;
+  key_compare comp_;
+};
+
+template <typename K, typename V, typename Comp>
+FlatTree<K, V, Comp>::FlatTree(const FlatTree &other) : comp_(other.comp_) {
+  reserve(other.size());
+  for (size_type i = 0; i < other.size(); ++i) {
+    keys_.push_back(other.keys_.begin()[i]);
+    if constexpr (kHasValues) values_.push_back(other.values_.begin()[i]);
+  }
+}
+
+template <typename K, typename V, typename Comp>
+FlatTree<K, V, Comp> &FlatTree<K, V, Comp>::operator=(const FlatTree &other) {
+  if (this != &other) {
+    FlatTree copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename Comp>
+void FlatTree<K, V, Comp>::reserve(size_type count) {
+  if (count <= keys_.capacity()) return;
+  keys_.reserve(count);
+  if constexpr (kHasValues) values_.reserve(count);
+}
+
+template <typename K, typename V, typename Comp>
+void FlatTree<K, V, Comp>::clear() noexcept {
+  keys_.clear();
+  if constexpr (kHasValues) values_.clear();
+}
+
+template <typename K, typename V, typename Comp>
+void FlatTree<K, V, Comp>::swap(FlatTree &other) noexcept {
+  keys_.swap(other.keys_);
+  if constexpr (kHasValues) values_.swap(other.values_);
+  std::swap(comp_, other.comp_);
+}
+
+template <typename K, typename V, typename Comp>
+void FlatTree<K, V, Comp>::erase(iterator pos) {
+  size_type index = index_(pos);
+  keys_.erase(keys_.begin() + index);
+  if constexpr (kHasValues) values_.erase(values_.begin() + index);
+}
+
+// Ключи other, которых здесь нет, переносятся одним слиянием.
+template <typename K, typename V, typename Comp>
+void FlatTree<K, V, Comp>::merge(FlatTree &other) {
+  if (this == &other) return;
+  size_type sorted = size();
+  reserve(sorted + other.size());
+  for (size_type i = 0; i < other.size(); ++i) {
+    if constexpr (kHasValues) {
+      append_(other.keys_.begin()[i], other.values_.begin()[i]);
+    } else {
+      append_(other.keys_.begin()[i]);
+    }
+  }
+  Vector<char> inserted = insert_tail_(sorted);
+  FlatTree rest(other.comp_);
+  for (size_type i = 0; i < other.size(); ++i) {
+    if (inserted.begin()[i]) continue;
+    if constexpr (kHasValues) {
+      rest.append_(other.keys_.begin()[i], other.values_.begin()[i]);
+    } else {
+      rest.append_(other.keys_.begin()[i]);
+    }
+  }
+  other.swap(rest);
+}
+
+template <typename K, typename V, typename Comp>
+std::pair<typename FlatTree<K, V, Comp>::iterator,
+          typename FlatTree<K, V, Comp>::iterator>
+FlatTree<K, V, Comp>::equal_range(const key_type &key) const {
+  size_type first = lower_index_(key);
+  size_type last = first;
+  if (last < size() && !comp_(key, keys_.begin()[last])) ++last;
+  return {at_(first), at_(last)};
+}
+
+template <typename K, typename V, typename Comp>
+inline typename FlatTree<K, V, Comp>::iterator FlatTree<K, V, Comp>::at_(
+    size_type index) const noexcept {
+  if constexpr (kHasValues) {
+    return iterator(keys_.begin() + index, values_.begin() + index);
+  } else {
+    return iterator(keys_.begin() + index, nullptr);
+  }
+}
+
+// Поиск без ветвлений, как в BTree::lower_index_.
+template <typename K, typename V, typename Comp>
+template <typename Key>
+inline typename FlatTree<K, V, Comp>::size_type
+FlatTree<K, V, Comp>::lower_index_(const Key &key) const {
+  const K *keys = keys_.begin();
+  size_type first = 0;
+  size_type length = keys_.size();
+  while (length > 1) {
+    size_type half = length / 2;
+    first = comp_(keys[first + half], key) ? first + half : first;
+    length -= half;
+  }
+  return first + (length == 1 && comp_(keys[first], key));
+}
+
+template <typename K, typename V, typename Comp>
+template <typename Key>
+inline typename FlatTree<K, V, Comp>::size_type
+FlatTree<K, V, Comp>::upper_index_(const Key &key) const {
+  const K *keys = keys_.begin();
+  size_type first = 0;
+  size_type length = keys_.size();
+  while (length > 1) {
+    size_type half = length / 2;
+    first = comp_(key, keys[first + half]) ? first : first + half;
+    length -= half;
+  }
+  return first + (length == 1 && !comp_(key, keys[first]));
+}
+
+template <typename K, typename V, typename Comp>
+template <typename Key>
+inline typename FlatTree<K, V, Comp>::iterator FlatTree<K, V, Comp>::find_(
+    const Key &key) const {
+  size_type index = lower_index_(key);
+  if (index < size() && !comp_(key, keys_.begin()[index])) return at_(index);
+  return end();
+}
+
+template <typename K, typename V, typename Comp>
+template <typename Key, typename... Args>
+std::pair<typename FlatTree<K, V, Comp>::iterator, bool>
+FlatTree<K, V, Comp>::insert_unique_(Key &&key, Args &&...args) {
+  size_type index = lower_index_(key);
+  if (index < size() && !comp_(key, keys_.begin()[index])) {
+    return {at_(index), false};
+  }
+  grow_();
+  keys_.insert(keys_.begin() + index, std::forward<Key>(key));
+  if constexpr (kHasValues) {
+    try {
+      values_.emplace(values_.begin() + index, std::forward<Args>(args)...);
+    } catch (...) {
+      keys_.erase(keys_.begin() + index);
+      throw;
+    }
+  }
+  return {at_(index), true};
+}
+
+template <typename K, typename V, typename Comp>
+template <typename... Args>
+void FlatTree<K, V, Comp>::append_(const key_type &key, Args &&...args) {
+  grow_();
+  keys_.push_back(key);
+  if constexpr (kHasValues) {
+    try {
+      values_.emplace_back(std::forward<Args>(args)...);
+    } catch (...) {
+      keys_.pop_back();
+      throw;
+    }
+  }
+}
+
+// Vector::reserve выделяет ровно запрошенное, поэтому рост удваивается
+// здесь, и оба массива растут вместе: вставка дальше не выделяет память.
+template <typename K, typename V, typename Comp>
+void FlatTree<K, V, Comp>::grow_() {
+  if (keys_.size() < keys_.capacity()) return;
+  reserve(keys_.capacity() ? keys_.capacity() * 2 : 8);
+}
+
+template <typename K, typename V, typename Comp>
+Vector<char> FlatTree<K, V, Comp>::insert_tail_(size_type sorted) {
+  const size_type tail = size() - sorted;
+  Vector<char> inserted(tail);
+  if (tail == 0) return inserted;
+  const K *keys = keys_.begin();
+  Vector<size_type> order(tail);
+  for (size_type i = 0; i < tail; ++i) order.begin()[i] = sorted + i;
+  std::stable_sort(order.begin(), order.end(),
+                   [this, keys](size_type a, size_type b) {
+                     return comp_(keys[a], keys[b]);
+                   });
+
+  Vector<K> merged_keys;
+  values_type merged_values;
+  merged_keys.reserve(size());
+  if constexpr (kHasValues) merged_values.reserve(size());
+  // Каждый элемент забирается ровно один раз, поэтому его можно перенести.
+  auto take = [&](size_type index) {
+    merged_keys.push_back(std::move_if_noexcept(keys_.begin()[index]));
+    if constexpr (kHasValues) {
+      merged_values.push_back(std::move_if_noexcept(values_.begin()[index]));
+    }
+  };
+  size_type old = 0;
+  for (size_type index : order) {
+    while (old < sorted && comp_(keys[old], keys[index])) take(old++);
+    if (old < sorted && !comp_(keys[index], keys[old])) continue;
+    if (merged_keys.size() > 0 &&
+        !comp_(merged_keys.begin()[merged_keys.size() - 1], keys[index])) {
+      continue;
+    }
+    take(index);
+    inserted.begin()[index - sorted] = 1;
+  }
+  while (old < sorted) take(old++);
+  keys_.swap(merged_keys);
+  if constexpr (kHasValues) values_.swap(merged_values);
+  return inserted;
+}
+
+}  // namespace s21
+
+#endif
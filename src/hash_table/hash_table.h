@@ -0,0 +1,708 @@
+#ifndef S21_HASH_TABLE_H
+#define S21_HASH_TABLE_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "../tree/tree.h"
+#include "../vector/vector.h"
+
+namespace s21 {
+
+// Heterogeneous lookup needs both Hash and KeyEqual to be transparent.
+template <typename Hash, typename KeyEqual, typename Key, typename = void>
+struct TransparentHashKey {};
+
+template <typename Hash, typename KeyEqual, typename Key>
+struct TransparentHashKey<Hash, KeyEqual, Key,
+                          std::void_t<typename Hash::is_transparent,
+                                      typename KeyEqual::is_transparent>> {
+  using type = Key;
+};
+
+template <typename Hash, typename KeyEqual, typename Key>
+using EnableIfTransparentHash =
+    typename TransparentHashKey<Hash, KeyEqual, Key>::type;
+
+// Шестнадцать управляющих байтов таблицы, сравниваемых одной SSE2-командой.
+// Байт >= 0 - занятая ячейка с семью младшими битами хеша (h2), kEmpty -
+// пустая, kDeleted - удаленная. Маски: бит i - байт i группы.
+class HashGroup {
+ public:
+  static constexpr std::size_t kWidth = 16;
+  static constexpr signed char kEmpty = -128;
+  static constexpr signed char kDeleted = -2;
+
+  explicit HashGroup(const signed char *ctrl) noexcept;
+
+  unsigned match(signed char h2) const noexcept;
+  unsigned match_empty() const noexcept;
+  unsigned match_empty_or_deleted() const noexcept;
+
+ private:
+#ifdef __SSE2__
+  __m128i ctrl_;
+#else
+  const signed char *ctrl_;
+#endif
+};
+
+#ifdef __SSE2__
+inline HashGroup::HashGroup(const signed char *ctrl) noexcept
+    : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {}
+
+inline unsigned HashGroup::match(signed char h2) const noexcept {
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+}
+
+inline unsigned HashGroup::match_empty() const noexcept {
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(kEmpty), ctrl_));
+}
+
+inline unsigned HashGroup::match_empty_or_deleted() const noexcept {
+  return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl_));
+}
+#else
+inline HashGroup::HashGroup(const signed char *ctrl) noexcept : ctrl_(ctrl) {}
+
+inline unsigned HashGroup::match(signed char h2) const noexcept {
+  unsigned mask = 0;
+  for (std::size_t i = 0; i < kWidth; ++i) mask |= (ctrl_[i] == h2) << i;
+  return mask;
+}
+
+inline unsigned HashGroup::match_empty() const noexcept {
+  return match(kEmpty);
+}
+
+inline unsigned HashGroup::match_empty_or_deleted() const noexcept {
+  unsigned mask = 0;
+  for (std::size_t i = 0; i < kWidth; ++i) mask |= (ctrl_[i] < -1) << i;
+  return mask;
+}
+#endif
+
+// Ячейка таблицы. Ключ отображения хранится неконстантным, чтобы при
+// перестройке и слиянии он перемещался, а не копировался; наружу ячейка
+// отдается как value_type. pair<K, V> и pair<const K, V> раскладываются
+// одинаково, на этом же держатся слоты abseil и узлы libc++.
+template <typename K, typename V>
+struct HashSlotTraits {
+  using slot_type = std::pair<K, V>;
+  using value_type = std::pair<const K, V>;
+  static_assert(sizeof(slot_type) == sizeof(value_type) &&
+                    alignof(slot_type) == alignof(value_type),
+                "pair<K, V> must share the layout of pair<const K, V>");
+
+  static const K &key(const slot_type &slot) noexcept { return slot.first; }
+  static value_type *value(slot_type *slot) noexcept {
+    return reinterpret_cast<value_type *>(slot);
+  }
+};
+
+template <typename K>
+struct HashSlotTraits<K, void> {
+  using slot_type = K;
+
+  static const K &key(const K &slot) noexcept { return slot; }
+  static const K *value(K *slot) noexcept { return slot; }
+};
+
+// Хеш-таблица с открытой адресацией (Swiss table): значения лежат прямо в
+// массиве ячеек, а отдельный массив управляющих байтов позволяет проверить
+// 16 кандидатов за одно сравнение. Старшие биты хеша (h1) задают начало
+// пробы, младшие семь (h2) хранятся в управляющем байте, так что ключи
+// сравниваются почти только при настоящем совпадении. Группы пробы идут с
+// треугольным шагом; за последней ячейкой повторены первые 16 байтов, чтобы
+// группа читалась без переноса. Раскладка значения - как у Tree, но ключ
+// в ячейке не константный (см. HashSlotTraits).
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<>,
+          typename Alloc = std::allocator<std::remove_const_t<
+              typename TreeValueTraits<K, V>::value_type>>>
+class HashTable {
+ public:
+  using key_type = K;
+  using mapped_type = typename TreeValueTraits<K, V>::mapped_type;
+  using value_type = typename TreeValueTraits<K, V>::value_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Alloc;
+
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = const Iterator;
+
+  HashTable() = default;
+  explicit HashTable(size_type bucket_count, const hasher &hash = hasher(),
+                     const key_equal &equal = key_equal(),
+                     const allocator_type &alloc = allocator_type());
+  HashTable(const HashTable &other);
+  HashTable(HashTable &&other) noexcept;
+  ~HashTable();
+
+  HashTable &operator=(const HashTable &other);
+  HashTable &operator=(HashTable &&other) noexcept;
+
+  iterator begin() const noexcept;
+  iterator end() const noexcept { return iterator(*this, capacity_); }
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  size_type max_size() const noexcept;
+
+  void clear() noexcept;
+  void swap(HashTable &other) noexcept;
+  void erase(iterator pos);
+  size_type erase(const key_type &key);
+  void merge(HashTable &other);
+
+  iterator find(const key_type &key) const { return find_(key); }
+  template <typename Key,
+            typename = EnableIfTransparentHash<Hash, KeyEqual, Key>>
+  iterator find(const Key &key) const {
+    return find_(key);
+  }
+  bool contains(const key_type &key) const { return find_(key) != end(); }
+  template <typename Key,
+            typename = EnableIfTransparentHash<Hash, KeyEqual, Key>>
+  bool contains(const Key &key) const {
+    return find_(key) != end();
+  }
+  size_type count(const key_type &key) const { return contains(key) ? 1 : 0; }
+
+  // Bucket interface: one bucket per slot.
+  size_type bucket_count() const noexcept { return capacity_; }
+  float load_factor() const noexcept;
+  float max_load_factor() const noexcept { return max_load_factor_; }
+  // Clamped to [1/16, 15/16]: the table always keeps an empty slot.
+  void max_load_factor(float load);
+  void rehash(size_type count);
+  void reserve(size_type count);
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return equal_; }
+  allocator_type get_allocator() const { return alloc_; }
+
+  class Iterator {
+   public:
+    Iterator(const HashTable &table, size_type index) noexcept
+        : table_(&table), index_(index) {}
+
+    bool operator==(const Iterator &other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const Iterator &other) const {
+      return index_ != other.index_;
+    }
+    const key_type &operator*() const {
+      return slot_traits::key(table_->slots_[index_]);
+    }
+    value_type *operator->() const {
+      return slot_traits::value(table_->slots_ + index_);
+    }
+
+    Iterator &operator++() noexcept;
+    Iterator operator++(int) noexcept;
+
+   private:
+    friend class HashTable;
+
+    const HashTable *table_;
+    size_type index_;
+  };
+
+ protected:
+  using slot_traits = HashSlotTraits<K, V>;
+  using slot_type = typename slot_traits::slot_type;
+  using ctrl_allocator_type = typename std::allocator_traits<
+      Alloc>::template rebind_alloc<signed char>;
+  using slot_allocator_type =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<slot_type>;
+
+  static constexpr size_type kWidth = HashGroup::kWidth;
+
+  template <typename Key>
+  size_type hash_of_(const Key &key) const;
+  template <typename Key>
+  iterator find_(const Key &key) const {
+    return iterator(*this, find_index_(key, hash_of_(key)));
+  }
+  // Номер ячейки с ключом или capacity_, если ключа нет.
+  template <typename Key>
+  size_type find_index_(const Key &key, size_type hash) const;
+  // Вставка, если ключа еще нет; args строят значение ячейки.
+  template <typename Key, typename... Args>
+  std::pair<iterator, bool> insert_unique_(const Key &key, Args &&...args);
+
+ private:
+  static size_type capacity_for_(size_type count, float load);
+  size_type growth_limit_(size_type capacity) const noexcept;
+  size_type find_insert_slot_(size_type hash) const noexcept {
+    return find_insert_slot_(ctrl_, capacity_, hash);
+  }
+  static size_type find_insert_slot_(const signed char *ctrl,
+                                     size_type capacity,
+                                     size_type hash) noexcept;
+  size_type prepare_insert_(size_type hash);
+  void set_ctrl_(size_type index, signed char value) noexcept {
+    set_ctrl_(ctrl_, capacity_, index, value);
+  }
+  static void set_ctrl_(signed char *ctrl, size_type capacity,
+                        size_type index, signed char value) noexcept;
+  void resize_(size_type capacity);
+  void destroy_() noexcept;
+
+  signed char *ctrl_ = nullptr;
+  slot_type *slots_ = nullptr;
+  size_type capacity_ = 0;
+  size_type size_ = 0;
+  size_type growth_left_ = 0;
+  float max_load_factor_ = 0.875f;
+  hasher hash_;
+  key_equal equal_;
+  allocator_type alloc_;
+};
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+HashTable<K, V, Hash, KeyEqual, Alloc>::HashTable(size_type bucket_count,
+                                                  const hasher &hash,
+                                                  const key_equal &equal,
+                                                  const allocator_type &alloc)
+    : hash_(hash), equal_(equal), alloc_(alloc) {
+  if (bucket_count > 0) rehash(bucket_count);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+HashTable<K, V, Hash, KeyEqual, Alloc>::HashTable(const HashTable &other)
+    : max_load_factor_(other.max_load_factor_),
+      hash_(other.hash_),
+      equal_(other.equal_),
+      alloc_(std::allocator_traits<Alloc>::
+                 select_on_container_copy_construction(other.alloc_)) {
+  reserve(other.size_);
+  for (iterator it = other.begin(); it != other.end(); ++it) {
+    insert_unique_(*it, *it.operator->());
+  }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+HashTable<K, V, Hash, KeyEqual, Alloc>::HashTable(HashTable &&other) noexcept
+    : ctrl_(other.ctrl_),
+      slots_(other.slots_),
+      capacity_(other.capacity_),
+      size_(other.size_),
+      growth_left_(other.growth_left_),
+      max_load_factor_(other.max_load_factor_),
+      hash_(other.hash_),
+      equal_(other.equal_),
+      alloc_(other.alloc_) {
+  other.ctrl_ = nullptr;
+  other.slots_ = nullptr;
+  other.capacity_ = other.size_ = other.growth_left_ = 0;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+HashTable<K, V, Hash, KeyEqual, Alloc>::~HashTable() {
+  destroy_();
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+HashTable<K, V, Hash, KeyEqual, Alloc> &
+HashTable<K, V, Hash, KeyEqual, Alloc>::operator=(const HashTable &other) {
+  if (this != &other) {
+    HashTable copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+HashTable<K, V, Hash, KeyEqual, Alloc> &
+HashTable<K, V, Hash, KeyEqual, Alloc>::operator=(HashTable &&other) noexcept {
+  if (this != &other) {
+    HashTable empty;
+    swap(empty);
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+typename HashTable<K, V, Hash, KeyEqual, Alloc>::iterator
+HashTable<K, V, Hash, KeyEqual, Alloc>::begin() const noexcept {
+  iterator it(*this, 0);
+  if (capacity_ != 0 && ctrl_[0] < 0) ++it;
+  return it;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+inline typename HashTable<K, V, Hash, KeyEqual, Alloc>::size_type
+HashTable<K, V, Hash, KeyEqual, Alloc>::max_size() const noexcept {
+  return std::numeric_limits<size_type>::max() / (sizeof(slot_type) + 1) / 2;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+void HashTable<K, V, Hash, KeyEqual, Alloc>::clear() noexcept {
+  if (capacity_ == 0) return;
+  if constexpr (!std::is_trivially_destructible_v<slot_type>) {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] >= 0) slots_[i].~slot_type();
+    }
+  }
+  std::memset(ctrl_, HashGroup::kEmpty, capacity_ + kWidth);
+  size_ = 0;
+  growth_left_ = growth_limit_(capacity_);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+void HashTable<K, V, Hash, KeyEqual, Alloc>::swap(HashTable &other) noexcept {
+  std::swap(ctrl_, other.ctrl_);
+  std::swap(slots_, other.slots_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(growth_left_, other.growth_left_);
+  std::swap(max_load_factor_, other.max_load_factor_);
+  std::swap(hash_, other.hash_);
+  std::swap(equal_, other.equal_);
+  std::swap(alloc_, other.alloc_);
+}
+
+// Ячейку можно снова пометить пустой, если вокруг нее нет 16 непустых
+// подряд: тогда ни одна проба не проходила через нее дальше. Иначе ставится
+// kDeleted, и место вернется только при перестройке.
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+void HashTable<K, V, Hash, KeyEqual, Alloc>::erase(iterator pos) {
+  size_type index = pos.index_;
+  slots_[index].~slot_type();
+  --size_;
+  unsigned before =
+      HashGroup(ctrl_ + ((index - kWidth) & (capacity_ - 1))).match_empty();
+  unsigned after = HashGroup(ctrl_ + index).match_empty();
+  if (before != 0 && after != 0 &&
+      static_cast<size_type>(__builtin_ctz(after) + __builtin_clz(before) -
+                             (32 - kWidth)) < kWidth) {
+    set_ctrl_(index, HashGroup::kEmpty);
+    ++growth_left_;
+  } else {
+    set_ctrl_(index, HashGroup::kDeleted);
+  }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+typename HashTable<K, V, Hash, KeyEqual, Alloc>::size_type
+HashTable<K, V, Hash, KeyEqual, Alloc>::erase(const key_type &key) {
+  iterator it = find_(key);
+  if (it == end()) return 0;
+  erase(it);
+  return 1;
+}
+
+// Удаление из таблицы не сдвигает остальные ячейки, поэтому перенесенные
+// значения убираются из other прямо во время обхода.
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+void HashTable<K, V, Hash, KeyEqual, Alloc>::merge(HashTable &other) {
+  if (this == &other) return;
+  for (iterator it = other.begin(); it != other.end(); ++it) {
+    slot_type *value = other.slots_ + it.index_;
+    if (insert_unique_(*it, std::move(*value)).second) other.erase(it);
+  }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+inline float HashTable<K, V, Hash, KeyEqual, Alloc>::load_factor()
+    const noexcept {
+  return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / capacity_;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+void HashTable<K, V, Hash, KeyEqual, Alloc>::max_load_factor(float load) {
+  if (!(load >= 1.0f / kWidth)) load = 1.0f / kWidth;
+  if (load > 1.0f - 1.0f / kWidth) load = 1.0f - 1.0f / kWidth;
+  max_load_factor_ = load;
+  if (capacity_ != 0) resize_(capacity_for_(size_, load));
+}
+
+// Как у std::unordered_map: не меньше count ячеек и не меньше, чем нужно
+// для size() при max_load_factor(); rehash(0) на пустой таблице отдает
+// память.
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+void HashTable<K, V, Hash, KeyEqual, Alloc>::rehash(size_type count) {
+  if (count == 0 && size_ == 0) {
+    destroy_();
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = growth_left_ = 0;
+    return;
+  }
+  size_type capacity = capacity_for_(size_, max_load_factor_);
+  while (capacity < count) capacity *= 2;
+  if (capacity != capacity_) resize_(capacity);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+void HashTable<K, V, Hash, KeyEqual, Alloc>::reserve(size_type count) {
+  if (count == 0) return;
+  if (count > size_ + growth_left_ || capacity_ == 0) {
+    size_type capacity = capacity_for_(count, max_load_factor_);
+    if (capacity > capacity_) resize_(capacity);
+  }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+typename HashTable<K, V, Hash, KeyEqual, Alloc>::Iterator &
+HashTable<K, V, Hash, KeyEqual, Alloc>::Iterator::operator++() noexcept {
+  const size_type capacity = table_->capacity_;
+  while (++index_ < capacity && table_->ctrl_[index_] < 0) {
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+inline typename HashTable<K, V, Hash, KeyEqual, Alloc>::Iterator
+HashTable<K, V, Hash, KeyEqual, Alloc>::Iterator::operator++(int) noexcept {
+  Iterator tmp(*this);
+  ++*this;
+  return tmp;
+}
+
+// std::hash для целых - тождество, поэтому хеш перемешивается умножением
+// на 64x64 -> 128 бит: каждый бит результата зависит от всех битов ключа.
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+template <typename Key>
+inline typename HashTable<K, V, Hash, KeyEqual, Alloc>::size_type
+HashTable<K, V, Hash, KeyEqual, Alloc>::hash_of_(const Key &key) const {
+  __uint128_t product = static_cast<__uint128_t>(hash_(key)) *
+                        UINT64_C(0x9E3779B97F4A7C15);
+  return static_cast<size_type>(product) ^
+         static_cast<size_type>(product >> 64);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+template <typename Key>
+typename HashTable<K, V, Hash, KeyEqual, Alloc>::size_type
+HashTable<K, V, Hash, KeyEqual, Alloc>::find_index_(const Key &key,
+                                                    size_type hash) const {
+  if (size_ == 0) return capacity_;
+  const size_type mask = capacity_ - 1;
+  const signed char h2 = static_cast<signed char>(hash & 0x7F);
+  size_type offset = (hash >> 7) & mask;
+  for (size_type step = kWidth;; step += kWidth) {
+    HashGroup group(ctrl_ + offset);
+    for (unsigned match = group.match(h2); match != 0; match &= match - 1) {
+      size_type index = (offset + __builtin_ctz(match)) & mask;
+      if (equal_(slot_traits::key(slots_[index]), key)) return index;
+    }
+    if (group.match_empty() != 0) return capacity_;
+    offset = (offset + step) & mask;
+  }
+}
+
+// Если конструктор значения бросит исключение, ячейка остается пустой и
+// запас роста возвращается.
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+template <typename Key, typename... Args>
+std::pair<typename HashTable<K, V, Hash, KeyEqual, Alloc>::iterator, bool>
+HashTable<K, V, Hash, KeyEqual, Alloc>::insert_unique_(const Key &key,
+                                                       Args &&...args) {
+  const size_type hash = hash_of_(key);
+  size_type index = find_index_(key, hash);
+  if (index != capacity_) return {iterator(*this, index), false};
+  index = prepare_insert_(hash);
+  try {
+    ::new (static_cast<void *>(slots_ + index))
+        slot_type(std::forward<Args>(args)...);
+  } catch (...) {
+    if (ctrl_[index] == HashGroup::kEmpty) ++growth_left_;
+    throw;
+  }
+  set_ctrl_(index, static_cast<signed char>(hash & 0x7F));
+  ++size_;
+  return {iterator(*this, index), true};
+}
+
+// Степень двойки, не меньше 16, при которой count помещается в предел
+// заполнения.
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+typename HashTable<K, V, Hash, KeyEqual, Alloc>::size_type
+HashTable<K, V, Hash, KeyEqual, Alloc>::capacity_for_(size_type count,
+                                                      float load) {
+  size_type capacity = kWidth;
+  while (static_cast<float>(capacity) * load < static_cast<float>(count)) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+inline typename HashTable<K, V, Hash, KeyEqual, Alloc>::size_type
+HashTable<K, V, Hash, KeyEqual, Alloc>::growth_limit_(
+    size_type capacity) const noexcept {
+  size_type limit =
+      static_cast<size_type>(static_cast<float>(capacity) * max_load_factor_);
+  return limit < capacity ? limit : capacity - 1;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+typename HashTable<K, V, Hash, KeyEqual, Alloc>::size_type
+HashTable<K, V, Hash, KeyEqual, Alloc>::find_insert_slot_(
+    const signed char *ctrl, size_type capacity, size_type hash) noexcept {
+  const size_type mask = capacity - 1;
+  size_type offset = (hash >> 7) & mask;
+  for (size_type step = kWidth;; step += kWidth) {
+    unsigned free = HashGroup(ctrl + offset).match_empty_or_deleted();
+    if (free != 0) return (offset + __builtin_ctz(free)) & mask;
+    offset = (offset + step) & mask;
+  }
+}
+
+// Удаленная ячейка занимается даром, пустая расходует запас роста. Когда
+// он кончился, таблица удваивается, а если больше половины предела занято
+// удаленными ячейками - перестраивается в том же размере.
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+typename HashTable<K, V, Hash, KeyEqual, Alloc>::size_type
+HashTable<K, V, Hash, KeyEqual, Alloc>::prepare_insert_(size_type hash) {
+  if (capacity_ == 0) resize_(kWidth);
+  size_type index = find_insert_slot_(hash);
+  if (growth_left_ == 0 && ctrl_[index] == HashGroup::kEmpty) {
+    resize_(size_ * 2 < growth_limit_(capacity_) ? capacity_ : capacity_ * 2);
+    index = find_insert_slot_(hash);
+  }
+  if (ctrl_[index] == HashGroup::kEmpty) --growth_left_;
+  return index;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+inline void HashTable<K, V, Hash, KeyEqual, Alloc>::set_ctrl_(
+    signed char *ctrl, size_type capacity, size_type index,
+    signed char value) noexcept {
+  ctrl[index] = value;
+  if (index < kWidth) ctrl[capacity + index] = value;
+}
+
+// Новая таблица собирается в локальных массивах, а поля меняются только
+// после успеха. Ячейки переносятся через move_if_noexcept: если перенос
+// может бросить, они копируются, и при ошибке старая таблица остается
+// целой. Если бросить может только хеш, хеши считаются заранее.
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+void HashTable<K, V, Hash, KeyEqual, Alloc>::resize_(size_type capacity) {
+  using ctrl_traits = std::allocator_traits<ctrl_allocator_type>;
+  using slot_alloc_traits = std::allocator_traits<slot_allocator_type>;
+  constexpr bool kPrehash =
+      std::is_nothrow_move_constructible_v<slot_type> &&
+      !noexcept(std::declval<const hasher &>()(
+          std::declval<const key_type &>()));
+  ctrl_allocator_type ctrl_alloc(alloc_);
+  slot_allocator_type slot_alloc(alloc_);
+  Vector<size_type> hashes;
+  if constexpr (kPrehash) {
+    hashes.reserve(size_);
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] >= 0) {
+        hashes.push_back(hash_of_(slot_traits::key(slots_[i])));
+      }
+    }
+  }
+
+  slot_type *slots = slot_alloc_traits::allocate(slot_alloc, capacity);
+  signed char *ctrl = nullptr;
+  try {
+    ctrl = ctrl_traits::allocate(ctrl_alloc, capacity + kWidth);
+  } catch (...) {
+    slot_alloc_traits::deallocate(slot_alloc, slots, capacity);
+    throw;
+  }
+  std::memset(ctrl, HashGroup::kEmpty, capacity + kWidth);
+  try {
+    size_type moved = 0;
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] < 0) continue;
+      size_type hash;
+      if constexpr (kPrehash) {
+        hash = hashes.begin()[moved++];
+      } else {
+        hash = hash_of_(slot_traits::key(slots_[i]));
+      }
+      const size_type index = find_insert_slot_(ctrl, capacity, hash);
+      ::new (static_cast<void *>(slots + index))
+          slot_type(std::move_if_noexcept(slots_[i]));
+      set_ctrl_(ctrl, capacity, index, static_cast<signed char>(hash & 0x7F));
+    }
+  } catch (...) {
+    for (size_type i = 0; i < capacity; ++i) {
+      if (ctrl[i] >= 0) slots[i].~slot_type();
+    }
+    ctrl_traits::deallocate(ctrl_alloc, ctrl, capacity + kWidth);
+    slot_alloc_traits::deallocate(slot_alloc, slots, capacity);
+    throw;
+  }
+
+  if (capacity_ != 0) {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] >= 0) slots_[i].~slot_type();
+    }
+    ctrl_traits::deallocate(ctrl_alloc, ctrl_, capacity_ + kWidth);
+    slot_alloc_traits::deallocate(slot_alloc, slots_, capacity_);
+  }
+  ctrl_ = ctrl;
+  slots_ = slots;
+  capacity_ = capacity;
+  growth_left_ = growth_limit_(capacity) - size_;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual,
+          typename Alloc>
+void HashTable<K, V, Hash, KeyEqual, Alloc>::destroy_() noexcept {
+  if (capacity_ == 0) return;
+  clear();
+  ctrl_allocator_type ctrl_alloc(alloc_);
+  slot_allocator_type slot_alloc(alloc_);
+  std::allocator_traits<ctrl_allocator_type>::deallocate(
+      ctrl_alloc, ctrl_, capacity_ + kWidth);
+  std::allocator_traits<slot_allocator_type>::deallocate(slot_alloc, slots_,
+                                                         capacity_);
+}
+
+}  // namespace s21
+
+#endif
@@ -7,27 +7,48 @@
 
 namespace s21 {
 
-template <typename K, typename T>
-class Map : public Tree<K, T> {
+template <typename K, typename T, typename Comp = std::less<>,
+          typename Alloc = SlabAllocator<std::pair<const K, T>>,
+          typename Stats = NoOrderStatistics>
+class Map : public Tree<K, T, Comp, Alloc, Stats> {
  public:
   using key_type = K;
   using mapped_type = T;
   using value_type = std::pair<const key_type, mapped_type>;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using iterator = typename Tree<K, T>::iterator;
-  using const_iterator = typename Tree<K, T>::const_iterator;
+  using iterator = typename Tree<K, T, Comp, Alloc, Stats>::iterator;
+  using const_iterator =
+      typename Tree<K, T, Comp, Alloc, Stats>::const_iterator;
   using size_type = size_t;
-
-  Map() : Tree<K, T>(){};
-  Map(std::initializer_list<value_type> const &items) : Tree<K, T>(items){};
-  Map(const Map &m) : Tree<K, T>(m){};
-  Map(Map &&m) : Tree<K, T>(std::move(m)){};
+  using key_compare = Comp;
+  using allocator_type = Alloc;
+  using node_type = typename Tree<K, T, Comp, Alloc, Stats>::node_type;
+  using insert_return_type =
+      typename Tree<K, T, Comp, Alloc, Stats>::insert_return_type;
+
+  Map() : Tree<K, T, Comp, Alloc, Stats>(){};
+  explicit Map(const allocator_type &alloc)
+      : Tree<K, T, Comp, Alloc, Stats>(alloc){};
+  explicit Map(const key_compare &comp,
+               const allocator_type &alloc = allocator_type())
+      : Tree<K, T, Comp, Alloc, Stats>(comp, alloc){};
+  Map(std::initializer_list<value_type> const &items)
+      : Tree<K, T, Comp, Alloc, Stats>(items){};
+  template <class InputIt, class = EnableIfIterator<InputIt>>
+  Map(InputIt first, InputIt last)
+      : Tree<K, T, Comp, Alloc, Stats>(first, last){};
+  Map(const Map &m) : Tree<K, T, Comp, Alloc, Stats>(m){};
+  Map(Map &&m) : Tree<K, T, Comp, Alloc, Stats>(std::move(m)){};
   ~Map() = default;
+  Map &operator=(const Map &m);
   Map operator=(const Map &&m);
 
   mapped_type &at(const key_type &key);
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  mapped_type &at(const Key &key);
   mapped_type &operator[](const key_type &key);
+  mapped_type &operator[](key_type &&key);
 
   iterator begin();
   iterator end();
@@ -38,141 +59,222 @@ class Map : public Tree<K, T> {
 
   void clear();
   std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
   std::pair<iterator, bool> insert(const key_type &key, const T &obj);
+  insert_return_type insert(node_type &&node);
   std::pair<iterator, bool> insert_or_assign(const key_type &key, const T &obj);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, T &&obj);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args);
   void erase(iterator pos);
   void swap(Map &other);
   void merge(Map &other);
 
+  // The Key overloads look up any type comparable with key_type when Comp
+  // is transparent, e.g. std::string_view for std::string keys.
+  iterator find(const key_type &key);
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  iterator find(const Key &key);
   bool contains(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  bool contains(const Key &key) const;
 
   template <class... Args>
   Vector<std::pair<iterator, bool>> insert_many(Args &&...args);
 };
 
-template <typename K, typename T>
-inline Map<K, T> Map<K, T>::operator=(const Map &&m) {
-  Tree<K, T>::operator=(std::move(m));
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline Map<K, T, Comp, Alloc, Stats> &
+Map<K, T, Comp, Alloc, Stats>::operator=(const Map &m) {
+  Tree<K, T, Comp, Alloc, Stats>::operator=(m);
   return *this;
 }
 
-template <typename K, typename T>
-inline T &Map<K, T>::at(const key_type &key) {
-  return Tree<K, T>::at(key);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline Map<K, T, Comp, Alloc, Stats>
+Map<K, T, Comp, Alloc, Stats>::operator=(const Map &&m) {
+  Tree<K, T, Comp, Alloc, Stats>::operator=(std::move(m));
+  return *this;
 }
 
-template <typename K, typename T>
-inline T &Map<K, T>::operator[](const key_type &key) {
-  return Tree<K, T>::operator[](key);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline T &Map<K, T, Comp, Alloc, Stats>::at(const key_type &key) {
+  return Tree<K, T, Comp, Alloc, Stats>::at(key);
 }
 
-template <typename K, typename T>
-inline typename Map<K, T>::iterator Map<K, T>::begin() {
-  return Tree<K, T>::begin();
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+template <typename Key, typename>
+inline T &Map<K, T, Comp, Alloc, Stats>::at(const Key &key) {
+  return Tree<K, T, Comp, Alloc, Stats>::at(key);
 }
 
-template <typename K, typename T>
-inline typename Map<K, T>::iterator Map<K, T>::end() {
-  return Tree<K, T>::end();
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline T &Map<K, T, Comp, Alloc, Stats>::operator[](const key_type &key) {
+  return Tree<K, T, Comp, Alloc, Stats>::operator[](key);
 }
 
-template <typename K, typename T>
-inline bool Map<K, T>::empty() const {
-  return Tree<K, T>::size() == 0;
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline T &Map<K, T, Comp, Alloc, Stats>::operator[](key_type &&key) {
+  return Tree<K, T, Comp, Alloc, Stats>::operator[](std::move(key));
 }
 
-template <typename K, typename T>
-inline typename Map<K, T>::size_type Map<K, T>::size() const {
-  return Tree<K, T>::size();
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline typename Map<K, T, Comp, Alloc, Stats>::iterator
+Map<K, T, Comp, Alloc, Stats>::begin() {
+  return Tree<K, T, Comp, Alloc, Stats>::begin();
 }
 
-template <typename K, typename T>
-inline typename Map<K, T>::size_type Map<K, T>::max_size() const {
-  return Tree<K, T>::max_size();
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline typename Map<K, T, Comp, Alloc, Stats>::iterator
+Map<K, T, Comp, Alloc, Stats>::end() {
+  return Tree<K, T, Comp, Alloc, Stats>::end();
 }
 
-template <typename K, typename T>
-inline void Map<K, T>::clear() {
-  Tree<K, T>::clear();
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline bool Map<K, T, Comp, Alloc, Stats>::empty() const {
+  return Tree<K, T, Comp, Alloc, Stats>::size() == 0;
 }
 
-template <typename K, typename T>
-inline std::pair<typename Map<K, T>::iterator, bool> Map<K, T>::insert(
-    const value_type &value) {
-  if (Tree<K, T>::contains(value.first)) {
-    iterator pos = Tree<K, T>::find_pos_(value.first);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline typename Map<K, T, Comp, Alloc, Stats>::size_type
+Map<K, T, Comp, Alloc, Stats>::size() const {
+  return Tree<K, T, Comp, Alloc, Stats>::size();
+}
 
-    return std::pair<iterator, bool>(pos, false);
-  }
-  Tree<K, T>::push_(value.first, value.second);
-  iterator pos = Tree<K, T>::find_pos_(value.first);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline typename Map<K, T, Comp, Alloc, Stats>::size_type
+Map<K, T, Comp, Alloc, Stats>::max_size() const {
+  return Tree<K, T, Comp, Alloc, Stats>::max_size();
+}
 
-  return std::pair<iterator, bool>(pos, true);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline void Map<K, T, Comp, Alloc, Stats>::clear() {
+  Tree<K, T, Comp, Alloc, Stats>::clear();
 }
 
-template <typename K, typename T>
-inline std::pair<typename Map<K, T>::iterator, bool> Map<K, T>::insert(
-    const key_type &key, const T &obj) {
-  if (Tree<K, T>::contains(key)) {
-    iterator pos = Tree<K, T>::find_pos_(key);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline std::pair<typename Map<K, T, Comp, Alloc, Stats>::iterator, bool>
+Map<K, T, Comp, Alloc, Stats>::insert(const value_type &value) {
+  return Tree<K, T, Comp, Alloc, Stats>::insert_value_(value);
+}
 
-    return std::pair<iterator, bool>(pos, false);
-  }
-  Tree<K, T>::push_(key, obj);
-  iterator pos = Tree<K, T>::find_pos_(key);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline std::pair<typename Map<K, T, Comp, Alloc, Stats>::iterator, bool>
+Map<K, T, Comp, Alloc, Stats>::insert(value_type &&value) {
+  return Tree<K, T, Comp, Alloc, Stats>::insert_value_(std::move(value));
+}
 
-  return std::pair<iterator, bool>(pos, true);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline std::pair<typename Map<K, T, Comp, Alloc, Stats>::iterator, bool>
+Map<K, T, Comp, Alloc, Stats>::insert(const key_type &key, const T &obj) {
+  return Tree<K, T, Comp, Alloc, Stats>::insert_value_({key, obj});
 }
 
-template <typename K, typename T>
-inline std::pair<typename Map<K, T>::iterator, bool>
-Map<K, T>::insert_or_assign(const key_type &key, const T &obj) {
-  if (Tree<K, T>::contains(key)) {
-    iterator pos = Tree<K, T>::find_pos_(key);
-    pos->second = obj;
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline std::pair<typename Map<K, T, Comp, Alloc, Stats>::iterator, bool>
+Map<K, T, Comp, Alloc, Stats>::insert_or_assign(const key_type &key,
+                                                const T &obj) {
+  std::pair<iterator, bool> result =
+      Tree<K, T, Comp, Alloc, Stats>::try_emplace_(key, obj);
+  if (!result.second) {
+    result.first->second = obj;
+  }
+  return result;
+}
 
-    return std::pair<iterator, bool>(pos, false);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline std::pair<typename Map<K, T, Comp, Alloc, Stats>::iterator, bool>
+Map<K, T, Comp, Alloc, Stats>::insert_or_assign(const key_type &key, T &&obj) {
+  std::pair<iterator, bool> result =
+      Tree<K, T, Comp, Alloc, Stats>::try_emplace_(key, std::move(obj));
+  if (!result.second) {
+    result.first->second = std::move(obj);
   }
-  Tree<K, T>::push_(key, obj);
-  iterator pos = Tree<K, T>::find_pos_(key);
+  return result;
+}
+
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+template <class... Args>
+inline std::pair<typename Map<K, T, Comp, Alloc, Stats>::iterator, bool>
+Map<K, T, Comp, Alloc, Stats>::emplace(Args &&...args) {
+  return Tree<K, T, Comp, Alloc, Stats>::emplace_(std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+template <class... Args>
+inline std::pair<typename Map<K, T, Comp, Alloc, Stats>::iterator, bool>
+Map<K, T, Comp, Alloc, Stats>::try_emplace(const key_type &key,
+                                           Args &&...args) {
+  return Tree<K, T, Comp, Alloc, Stats>::try_emplace_(
+      key, std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+template <class... Args>
+inline std::pair<typename Map<K, T, Comp, Alloc, Stats>::iterator, bool>
+Map<K, T, Comp, Alloc, Stats>::try_emplace(key_type &&key, Args &&...args) {
+  return Tree<K, T, Comp, Alloc, Stats>::try_emplace_(
+      std::move(key), std::forward<Args>(args)...);
+}
+
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline typename Map<K, T, Comp, Alloc, Stats>::insert_return_type
+Map<K, T, Comp, Alloc, Stats>::insert(node_type &&node) {
+  return Tree<K, T, Comp, Alloc, Stats>::insert_node_(std::move(node));
+}
+
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline void Map<K, T, Comp, Alloc, Stats>::erase(iterator pos) {
+  Tree<K, T, Comp, Alloc, Stats>::erase(pos);
+}
+
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline void Map<K, T, Comp, Alloc, Stats>::swap(Map &other) {
+  Tree<K, T, Comp, Alloc, Stats>::swap(other);
+}
 
-  return std::pair<iterator, bool>(pos, true);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline void Map<K, T, Comp, Alloc, Stats>::merge(Map &other) {
+  Tree<K, T, Comp, Alloc, Stats>::merge(other);
 }
 
-template <typename K, typename T>
-inline void Map<K, T>::erase(iterator pos) {
-  Tree<K, T>::erase(pos);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline typename Map<K, T, Comp, Alloc, Stats>::iterator
+Map<K, T, Comp, Alloc, Stats>::find(const key_type &key) {
+  return Tree<K, T, Comp, Alloc, Stats>::find_pos_(key);
 }
 
-template <typename K, typename T>
-inline void Map<K, T>::swap(Map &other) {
-  Tree<K, T>::swap(other);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+template <typename Key, typename>
+inline typename Map<K, T, Comp, Alloc, Stats>::iterator
+Map<K, T, Comp, Alloc, Stats>::find(const Key &key) {
+  return Tree<K, T, Comp, Alloc, Stats>::find_pos_(key);
 }
 
-template <typename K, typename T>
-inline void Map<K, T>::merge(Map &other) {
-  Tree<K, T>::merge(other);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+inline bool Map<K, T, Comp, Alloc, Stats>::contains(const key_type &key) const {
+  return Tree<K, T, Comp, Alloc, Stats>::contains(key);
 }
 
-template <typename K, typename T>
-inline bool Map<K, T>::contains(const key_type &key) const {
-  return Tree<K, T>::contains(key);
+template <typename K, typename T, typename Comp, typename Alloc, typename Stats>
+template <typename Key, typename>
+inline bool Map<K, T, Comp, Alloc, Stats>::contains(const Key &key) const {
+  return Tree<K, T, Comp, Alloc, Stats>::contains(key);
 }
 
-template <typename key_type, typename mapped_type>
+template <typename key_type, typename mapped_type, typename Comp,
+          typename Alloc, typename Stats>
 template <class... Args>
-Vector<std::pair<typename Map<key_type, mapped_type>::iterator, bool>>
-Map<key_type, mapped_type>::insert_many(Args &&...args) {
-  Vector<std::pair<typename Tree<key_type, mapped_type>::iterator, bool>> ret;
+Vector<std::pair<
+    typename Map<key_type, mapped_type, Comp, Alloc, Stats>::iterator, bool>>
+Map<key_type, mapped_type, Comp, Alloc, Stats>::insert_many(Args &&...args) {
+  Vector<std::pair<iterator, bool>> ret;
   for (auto arg : {args...}) {
-    if (contains(arg.first)) {
-      ret.push_back(
-          std::pair(Tree<key_type, mapped_type>::find_pos_(arg.first), false));
-    } else {
-      Tree<key_type, mapped_type>::push_(arg.first, arg.second);
-      ret.push_back(
-          std::pair(Tree<key_type, mapped_type>::find_pos_(arg.first), true));
-    }
+    ret.push_back(insert(arg));
   }
   return ret;
 }
@@ -5,22 +5,34 @@
 
 namespace s21 {
 
-template <typename Key>
-class Multiset : public Set<Key> {
+template <typename Key, typename Comp = std::less<>,
+          typename Alloc = SlabAllocator<Key>,
+          typename Stats = NoOrderStatistics>
+class Multiset : public Set<Key, Comp, Alloc, Stats> {
  public:
   using key_type = Key;
   using value_type = key_type;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using iterator = typename Tree<key_type, value_type>::iterator;
+  using iterator = typename Tree<key_type, void, Comp, Alloc, Stats>::iterator;
 
   using size_type = std::size_t;
+  using key_compare = Comp;
+  using allocator_type = Alloc;
+  using node_type =
+      typename Tree<key_type, void, Comp, Alloc, Stats>::node_type;
 
   Multiset();
+  explicit Multiset(const allocator_type &alloc);
+  explicit Multiset(const key_compare &comp,
+                    const allocator_type &alloc = allocator_type());
   Multiset(std::initializer_list<value_type> const &items);
+  template <class InputIt, class = EnableIfIterator<InputIt>>
+  Multiset(InputIt first, InputIt last);
   Multiset(const Multiset &ms);
   Multiset(Multiset &&ms);
   ~Multiset() = default;
+  Multiset &operator=(const Multiset &ms);
   Multiset &operator=(Multiset &&ms);
 
   iterator begin();
@@ -34,9 +46,13 @@ class Multiset : public Set<Key> {
   iterator insert(
       const value_type &value);  // inserts node and returns iterator to where
                                  // the element is in the container
-  void erase(iterator pos);      // erases element at pos
-  void swap(Multiset &other);    // swaps the contents
-  void merge(Multiset &other);   // splices nodes from another container
+  iterator insert(value_type &&value);  // moves value into a new node
+  iterator insert(node_type &&node);    // links an extracted node
+  template <class... Args>
+  iterator emplace(Args &&...args);  // constructs element in place
+  void erase(iterator pos);          // erases element at pos
+  void swap(Multiset &other);        // swaps the contents
+  void merge(Multiset &other);  // splices nodes from another container
 
   size_type count(
       const Key &key);  // returns the number of elements matching specific key
@@ -44,162 +60,258 @@ class Multiset : public Set<Key> {
   bool contains(const Key &key);  // checks if the container contains element
                                   // with specific key
   std::pair<iterator, iterator> equal_range(
-      const Key &key);  // returns range of elements matching a specific key
+      const Key &key);  // returns the first and the last element matching
+                        // key, or end() twice if there is none
   iterator lower_bound(const Key &key);  // returns an iterator to the first
                                          // element not less than the given key
   iterator upper_bound(const Key &key);  // returns an iterator to the first
                                          // element greater than the given key
 
+  // Heterogeneous overloads, enabled when Comp is transparent.
+  template <typename K, typename = EnableIfTransparent<Comp, K>>
+  size_type count(const K &key);
+  template <typename K, typename = EnableIfTransparent<Comp, K>>
+  iterator find(const K &key);
+  template <typename K, typename = EnableIfTransparent<Comp, K>>
+  bool contains(const K &key);
+  template <typename K, typename = EnableIfTransparent<Comp, K>>
+  std::pair<iterator, iterator> equal_range(const K &key);
+  template <typename K, typename = EnableIfTransparent<Comp, K>>
+  iterator lower_bound(const K &key);
+  template <typename K, typename = EnableIfTransparent<Comp, K>>
+  iterator upper_bound(const K &key);
+
   template <class... Args>
   Vector<std::pair<iterator, bool>> insert_many(Args &&...args);
 };
 
-template <typename T>
-Multiset<T>::Multiset() : Set<T>() {
-  Set<T>::is_multi_set = true;
+template <typename T, typename Comp, typename Alloc, typename Stats>
+Multiset<T, Comp, Alloc, Stats>::Multiset() : Set<T, Comp, Alloc, Stats>() {
+  Set<T, Comp, Alloc, Stats>::is_multi_set = true;
+}
+
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline Multiset<Key, Comp, Alloc, Stats>::Multiset(const allocator_type &alloc)
+    : Set<Key, Comp, Alloc, Stats>(alloc) {
+  Set<Key, Comp, Alloc, Stats>::is_multi_set = true;
+}
+
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline Multiset<Key, Comp, Alloc, Stats>::Multiset(const key_compare &comp,
+                                                    const allocator_type &alloc)
+    : Set<Key, Comp, Alloc, Stats>(comp, alloc) {
+  Set<Key, Comp, Alloc, Stats>::is_multi_set = true;
+}
+
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline Multiset<Key, Comp, Alloc, Stats>::Multiset(
+    std::initializer_list<value_type> const &items)
+    : Set<Key, Comp, Alloc, Stats>() {
+  Set<Key, Comp, Alloc, Stats>::is_multi_set = true;
+  Set<Key, Comp, Alloc, Stats>::assign_sorted(items.begin(), items.end());
 }
 
-template <typename Key>
-inline Multiset<Key>::Multiset(std::initializer_list<value_type> const &items)
-    : Set<Key>() {
-  Set<Key>::is_multi_set = true;
-  for (auto &item : items) {
-    Set<Key>::insert(item);
-  }
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+template <class InputIt, class>
+inline Multiset<Key, Comp, Alloc, Stats>::Multiset(InputIt first, InputIt last)
+    : Set<Key, Comp, Alloc, Stats>() {
+  Set<Key, Comp, Alloc, Stats>::is_multi_set = true;
+  Set<Key, Comp, Alloc, Stats>::assign_sorted(first, last);
 }
 
-template <typename Key>
-inline Multiset<Key>::Multiset(const Multiset &ms) : Set<Key>(ms) {
-  Set<Key>::is_multi_set = true;
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline Multiset<Key, Comp, Alloc, Stats>::Multiset(const Multiset &ms)
+    : Set<Key, Comp, Alloc, Stats>(ms) {
+  Set<Key, Comp, Alloc, Stats>::is_multi_set = true;
 }
 
-template <typename Key>
-inline Multiset<Key>::Multiset(Multiset &&ms) : Set<Key>(std::move(ms)) {
-  Set<Key>::is_multi_set = true;
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline Multiset<Key, Comp, Alloc, Stats>::Multiset(Multiset &&ms)
+    : Set<Key, Comp, Alloc, Stats>(std::move(ms)) {
+  Set<Key, Comp, Alloc, Stats>::is_multi_set = true;
 }
 
-template <typename Key>
-inline Multiset<Key> &Multiset<Key>::operator=(Multiset &&ms) {
-  Set<Key>::operator=(std::move(ms));
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline Multiset<Key, Comp, Alloc, Stats> &
+Multiset<Key, Comp, Alloc, Stats>::operator=(const Multiset &ms) {
+  Set<Key, Comp, Alloc, Stats>::operator=(ms);
   return *this;
 }
 
-template <typename Key>
-inline typename Multiset<Key>::iterator Multiset<Key>::begin() {
-  return Set<Key>::begin();
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline Multiset<Key, Comp, Alloc, Stats> &
+Multiset<Key, Comp, Alloc, Stats>::operator=(Multiset &&ms) {
+  Set<Key, Comp, Alloc, Stats>::operator=(std::move(ms));
+  return *this;
+}
+
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline typename Multiset<Key, Comp, Alloc, Stats>::iterator
+Multiset<Key, Comp, Alloc, Stats>::begin() {
+  return Set<Key, Comp, Alloc, Stats>::begin();
 }
 
-template <typename Key>
-inline typename Multiset<Key>::iterator Multiset<Key>::end() {
-  return Set<Key>::end();
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline typename Multiset<Key, Comp, Alloc, Stats>::iterator
+Multiset<Key, Comp, Alloc, Stats>::end() {
+  return Set<Key, Comp, Alloc, Stats>::end();
 }
 
-template <typename Key>
-inline bool Multiset<Key>::empty() {
-  return Set<Key>::empty();
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline bool Multiset<Key, Comp, Alloc, Stats>::empty() {
+  return Set<Key, Comp, Alloc, Stats>::empty();
 }
 
-template <typename Key>
-inline typename Multiset<Key>::size_type Multiset<Key>::size() {
-  return Set<Key>::size();
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline typename Multiset<Key, Comp, Alloc, Stats>::size_type
+Multiset<Key, Comp, Alloc, Stats>::size() {
+  return Set<Key, Comp, Alloc, Stats>::size();
 }
 
-template <typename Key>
-inline typename Multiset<Key>::size_type Multiset<Key>::max_size() {
-  return Set<Key>::max_size();
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline typename Multiset<Key, Comp, Alloc, Stats>::size_type
+Multiset<Key, Comp, Alloc, Stats>::max_size() {
+  return Set<Key, Comp, Alloc, Stats>::max_size();
 }
 
-template <typename Key>
-inline void Multiset<Key>::clear() {
-  Set<Key>::clear();
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline void Multiset<Key, Comp, Alloc, Stats>::clear() {
+  Set<Key, Comp, Alloc, Stats>::clear();
 }
 
-template <typename Key>
-inline typename Multiset<Key>::iterator Multiset<Key>::insert(
-    const value_type &value) {
-  return Set<Key>::insert(value).first;
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline typename Multiset<Key, Comp, Alloc, Stats>::iterator
+Multiset<Key, Comp, Alloc, Stats>::insert(const value_type &value) {
+  return Set<Key, Comp, Alloc, Stats>::insert(value).first;
 }
 
-template <typename Key>
-inline void Multiset<Key>::erase(iterator pos) {
-  Set<Key>::erase(pos);
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline typename Multiset<Key, Comp, Alloc, Stats>::iterator
+Multiset<Key, Comp, Alloc, Stats>::insert(value_type &&value) {
+  return Set<Key, Comp, Alloc, Stats>::insert(std::move(value)).first;
 }
 
-template <typename Key>
-inline void Multiset<Key>::swap(Multiset &other) {
-  Set<Key>::swap(other);
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline typename Multiset<Key, Comp, Alloc, Stats>::iterator
+Multiset<Key, Comp, Alloc, Stats>::insert(node_type &&node) {
+  return Set<Key, Comp, Alloc, Stats>::insert(std::move(node)).position;
 }
 
-template <typename Key>
-inline void Multiset<Key>::merge(Multiset &other) {
-  Set<Key>::merge(other);
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+template <class... Args>
+inline typename Multiset<Key, Comp, Alloc, Stats>::iterator
+Multiset<Key, Comp, Alloc, Stats>::emplace(Args &&...args) {
+  return Set<Key, Comp, Alloc, Stats>::emplace(std::forward<Args>(args)...)
+      .first;
 }
 
-template <typename Key>
-inline typename Multiset<Key>::size_type Multiset<Key>::count(const Key &key) {
-  size_type count = 0;
-  for (auto it = begin(); it != end(); ++it) {
-    if (*it == key) {
-      count++;
-    }
-  }
-  return count;
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline void Multiset<Key, Comp, Alloc, Stats>::erase(iterator pos) {
+  Set<Key, Comp, Alloc, Stats>::erase(pos);
 }
 
-template <typename Key>
-inline typename Multiset<Key>::iterator Multiset<Key>::find(const Key &key) {
-  return Set<Key>::find(key);
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline void Multiset<Key, Comp, Alloc, Stats>::swap(Multiset &other) {
+  Set<Key, Comp, Alloc, Stats>::swap(other);
 }
 
-template <typename Key>
-inline bool Multiset<Key>::contains(const Key &key) {
-  return Set<Key>::contains(key);
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline void Multiset<Key, Comp, Alloc, Stats>::merge(Multiset &other) {
+  Set<Key, Comp, Alloc, Stats>::merge(other);
 }
 
-template <typename Key>
-inline std::pair<typename Multiset<Key>::iterator,
-                 typename Multiset<Key>::iterator>
-Multiset<Key>::equal_range(const Key &key) {
-  iterator it_first = end();
-  iterator it_second = end();
-  bool found = false;
-  for (auto it = begin(); it != end(); ++it) {
-    if (*it == key) {
-      if (!found) {
-        it_first = it;
-        found = true;
-      }
-      it_second = it;
-    }
-  }
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline typename Multiset<Key, Comp, Alloc, Stats>::size_type
+Multiset<Key, Comp, Alloc, Stats>::count(const Key &key) {
+  return Set<Key, Comp, Alloc, Stats>::count(key);
+}
+
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline typename Multiset<Key, Comp, Alloc, Stats>::iterator
+Multiset<Key, Comp, Alloc, Stats>::find(const Key &key) {
+  return Set<Key, Comp, Alloc, Stats>::find(key);
+}
+
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline bool Multiset<Key, Comp, Alloc, Stats>::contains(const Key &key) {
+  return Set<Key, Comp, Alloc, Stats>::contains(key);
+}
+
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline std::pair<typename Multiset<Key, Comp, Alloc, Stats>::iterator,
+                 typename Multiset<Key, Comp, Alloc, Stats>::iterator>
+Multiset<Key, Comp, Alloc, Stats>::equal_range(const Key &key) {
+  std::pair<iterator, iterator> range =
+      Set<Key, Comp, Alloc, Stats>::equal_range(key);
+  if (range.first == range.second) return {end(), end()};
+  --range.second;
+  return range;
+}
+
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline typename Multiset<Key, Comp, Alloc, Stats>::iterator
+Multiset<Key, Comp, Alloc, Stats>::lower_bound(const Key &key) {
+  return Set<Key, Comp, Alloc, Stats>::lower_bound(key);
+}
+
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+inline typename Multiset<Key, Comp, Alloc, Stats>::iterator
+Multiset<Key, Comp, Alloc, Stats>::upper_bound(const Key &key) {
+  return Set<Key, Comp, Alloc, Stats>::upper_bound(key);
+}
+
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+template <typename K, typename>
+inline typename Multiset<Key, Comp, Alloc, Stats>::size_type
+Multiset<Key, Comp, Alloc, Stats>::count(const K &key) {
+  return Set<Key, Comp, Alloc, Stats>::count(key);
+}
+
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+template <typename K, typename>
+inline typename Multiset<Key, Comp, Alloc, Stats>::iterator
+Multiset<Key, Comp, Alloc, Stats>::find(const K &key) {
+  return Set<Key, Comp, Alloc, Stats>::find(key);
+}
+
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+template <typename K, typename>
+inline bool Multiset<Key, Comp, Alloc, Stats>::contains(const K &key) {
+  return Set<Key, Comp, Alloc, Stats>::contains(key);
+}
 
-  return std::pair<typename Multiset<Key>::iterator,
-                   typename Multiset<Key>::iterator>(it_first, it_second);
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+template <typename K, typename>
+inline std::pair<typename Multiset<Key, Comp, Alloc, Stats>::iterator,
+                 typename Multiset<Key, Comp, Alloc, Stats>::iterator>
+Multiset<Key, Comp, Alloc, Stats>::equal_range(const K &key) {
+  std::pair<iterator, iterator> range =
+      Set<Key, Comp, Alloc, Stats>::equal_range(key);
+  if (range.first == range.second) return {end(), end()};
+  --range.second;
+  return range;
 }
 
-template <typename Key>
-inline typename Multiset<Key>::iterator Multiset<Key>::lower_bound(
-    const Key &key) {
-  for (auto it = begin(); it != end(); ++it) {
-    if (*it >= key) return it;
-  }
-  return end();
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+template <typename K, typename>
+inline typename Multiset<Key, Comp, Alloc, Stats>::iterator
+Multiset<Key, Comp, Alloc, Stats>::lower_bound(const K &key) {
+  return Set<Key, Comp, Alloc, Stats>::lower_bound(key);
 }
 
-template <typename Key>
-inline typename Multiset<Key>::iterator Multiset<Key>::upper_bound(
-    const Key &key) {
-  for (auto it = begin(); it != end(); ++it) {
-    if (*it > key) return it;
-  }
-  return end();
+template <typename Key, typename Comp, typename Alloc, typename Stats>
+template <typename K, typename>
+inline typename Multiset<Key, Comp, Alloc, Stats>::iterator
+Multiset<Key, Comp, Alloc, Stats>::upper_bound(const K &key) {
+  return Set<Key, Comp, Alloc, Stats>::upper_bound(key);
 }
 
-template <typename Key>
+template <typename Key, typename Comp, typename Alloc, typename Stats>
 template <class... Args>
-inline Vector<std::pair<typename Multiset<Key>::iterator, bool>>
-Multiset<Key>::insert_many(Args &&...args) {
-  return Set<Key>::insert_many(std::forward<Args>(args)...);
+inline Vector<
+    std::pair<typename Multiset<Key, Comp, Alloc, Stats>::iterator, bool>>
+Multiset<Key, Comp, Alloc, Stats>::insert_many(Args &&...args) {
+  return Set<Key, Comp, Alloc, Stats>::insert_many(std::forward<Args>(args)...);
 }
 
 }  // namespace s21
@@ -1,6 +1,7 @@
 #ifndef S21_CONTAINERS_H
 #define S21_CONTAINERS_H
 
+#include "allocator/slab_allocator.h"
 #include "list/list.h"
 #include "map/map.h"
 #include "queue/queue.h"
@@ -1,5 +1,14 @@
 #ifndef S21_CONTAINERS_PLUS_H
 #define S21_CONTAINERS_PLUS_H
 
+#include "btree_map/btree_map.h"
+#include "btree_set/btree_set.h"
+#include "counted_multiset/counted_multiset.h"
+#include "flat_map/flat_map.h"
+#include "flat_set/flat_set.h"
 #include "multiset/multiset.h"
+#include "static_map/static_map.h"
+#include "static_set/static_set.h"
+#include "unordered_map/unordered_map.h"
+#include "unordered_set/unordered_set.h"
 #endif
\ No newline at end of file
@@ -9,24 +9,41 @@
 
 namespace s21 {
 
-template <typename Value>
-class Set : public Tree<Value, Value> {
+template <typename Value, typename Comp = std::less<>,
+          typename Alloc = SlabAllocator<Value>,
+          typename Stats = NoOrderStatistics>
+class Set : public Tree<Value, void, Comp, Alloc, Stats> {
  public:
   using key_type = Value;
   using value_type = Value;
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = size_t;
-
-  Set() : Tree<key_type, value_type>(){};
+  using key_compare = Comp;
+  using allocator_type = Alloc;
+  using node_type =
+      typename Tree<key_type, void, Comp, Alloc, Stats>::node_type;
+  using insert_return_type =
+      typename Tree<key_type, void, Comp, Alloc, Stats>::insert_return_type;
+
+  Set() : Tree<key_type, void, Comp, Alloc, Stats>(){};
+  explicit Set(const allocator_type &alloc)
+      : Tree<key_type, void, Comp, Alloc, Stats>(alloc){};
+  explicit Set(const key_compare &comp,
+               const allocator_type &alloc = allocator_type())
+      : Tree<key_type, void, Comp, Alloc, Stats>(comp, alloc){};
   Set(std::initializer_list<value_type> const &items);
-  Set(const Set &s) : Tree<key_type, value_type>(s){};
-  Set(Set &&s) : Tree<key_type, value_type>(std::move(s)){};
+  template <class InputIt, class = EnableIfIterator<InputIt>>
+  Set(InputIt first, InputIt last);
+  Set(const Set &s) : Tree<key_type, void, Comp, Alloc, Stats>(s){};
+  Set(Set &&s) : Tree<key_type, void, Comp, Alloc, Stats>(std::move(s)){};
   ~Set() = default;
+  Set &operator=(const Set &s);
   Set &operator=(Set &&s);
 
-  using iterator = typename Tree<key_type, value_type>::iterator;
-  using const_iterator = typename Tree<key_type, value_type>::const_iterator;
+  using iterator = typename Tree<key_type, void, Comp, Alloc, Stats>::iterator;
+  using const_iterator =
+      typename Tree<key_type, void, Comp, Alloc, Stats>::const_iterator;
 
   bool operator==(const iterator &it);
   iterator begin();
@@ -38,120 +55,172 @@ class Set : public Tree<Value, Value> {
 
   void clear();
   std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  insert_return_type insert(node_type &&node);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
   void erase(iterator pos);
   void swap(Set &other);
   void merge(Set &other);
 
+  // The Key overloads look up any type comparable with key_type when Comp
+  // is transparent, e.g. std::string_view for std::string keys.
   iterator find(const key_type &key);
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  iterator find(const Key &key);
 
   bool contains(const key_type &key);
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  bool contains(const Key &key);
 
   template <class... Args>
   Vector<std::pair<iterator, bool>> insert_many(Args &&...args);
 };
 
-template <typename value_type>
-inline Set<value_type>::Set(std::initializer_list<value_type> const &items)
-    : Tree<value_type, value_type>() {
-  // Tree<value_type, value_type>();
-  for (const auto &item : items) {
-    insert(item);
-  }
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+inline Set<value_type, Comp, Alloc, Stats>::Set(
+    std::initializer_list<value_type> const &items)
+    : Tree<value_type, void, Comp, Alloc, Stats>() {
+  // Tree<value_type, void, Comp, Alloc, Stats>();
+  Tree<value_type, void, Comp, Alloc, Stats>::assign_sorted(
+      items.begin(), items.end());
+}
+
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+template <class InputIt, class>
+inline Set<value_type, Comp, Alloc, Stats>::Set(InputIt first, InputIt last)
+    : Tree<value_type, void, Comp, Alloc, Stats>() {
+  Tree<value_type, void, Comp, Alloc, Stats>::assign_sorted(first, last);
 }
 
-template <typename value_type>
-inline Set<value_type> &Set<value_type>::operator=(Set<value_type> &&s) {
-  Tree<value_type, value_type>::operator=(std::move(s));
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+inline Set<value_type, Comp, Alloc, Stats> &
+Set<value_type, Comp, Alloc, Stats>::operator=(
+    const Set<value_type, Comp, Alloc, Stats> &s) {
+  Tree<value_type, void, Comp, Alloc, Stats>::operator=(s);
   return *this;
 }
 
-template <typename value_type>
-inline typename Set<value_type>::iterator Set<value_type>::begin() {
-  return Tree<value_type, value_type>::begin();
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+inline Set<value_type, Comp, Alloc, Stats> &
+Set<value_type, Comp, Alloc, Stats>::operator=(
+    Set<value_type, Comp, Alloc, Stats> &&s) {
+  Tree<value_type, void, Comp, Alloc, Stats>::operator=(std::move(s));
+  return *this;
+}
+
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+inline typename Set<value_type, Comp, Alloc, Stats>::iterator
+Set<value_type, Comp, Alloc, Stats>::begin() {
+  return Tree<value_type, void, Comp, Alloc, Stats>::begin();
 }
 
-template <typename value_type>
-inline typename Set<value_type>::iterator Set<value_type>::end() {
-  return Tree<value_type, value_type>::end();
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+inline typename Set<value_type, Comp, Alloc, Stats>::iterator
+Set<value_type, Comp, Alloc, Stats>::end() {
+  return Tree<value_type, void, Comp, Alloc, Stats>::end();
 }
 
-template <typename value_type>
-inline bool Set<value_type>::empty() {
-  return Tree<value_type, value_type>::empty();
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+inline bool Set<value_type, Comp, Alloc, Stats>::empty() {
+  return Tree<value_type, void, Comp, Alloc, Stats>::empty();
 }
 
-template <typename value_type>
-inline typename Set<value_type>::size_type Set<value_type>::size() {
-  return Tree<value_type, value_type>::size();
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+inline typename Set<value_type, Comp, Alloc, Stats>::size_type
+Set<value_type, Comp, Alloc, Stats>::size() {
+  return Tree<value_type, void, Comp, Alloc, Stats>::size();
 }
 
 // TODO: выяснить, как возвращать максимальный размер правильно
-template <typename value_type>
-inline typename Set<value_type>::size_type Set<value_type>::max_size() {
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+inline typename Set<value_type, Comp, Alloc, Stats>::size_type
+Set<value_type, Comp, Alloc, Stats>::max_size() {
   return std::numeric_limits<size_type>::max() /
-         sizeof(typename Tree<value_type, value_type>::Node) / 2;
+         sizeof(typename Tree<value_type, void, Comp, Alloc, Stats>::Node) /
+         2;
 }
 
-template <typename value_type>
-inline typename std::pair<typename Set<value_type>::iterator, bool>
-Set<value_type>::insert(const value_type &value) {
-  if (Tree<value_type, value_type>::contains(value) &&
-      !Tree<value_type, value_type>::is_multi_set) {
-    iterator pos = Tree<value_type, value_type>::find_pos_(value);
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+inline std::pair<typename Set<value_type, Comp, Alloc, Stats>::iterator, bool>
+Set<value_type, Comp, Alloc, Stats>::insert(const value_type &value) {
+  return Tree<value_type, void, Comp, Alloc, Stats>::insert_value_(value);
+}
 
-    return std::pair<iterator, bool>(pos, false);
-  }
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+inline std::pair<typename Set<value_type, Comp, Alloc, Stats>::iterator, bool>
+Set<value_type, Comp, Alloc, Stats>::insert(value_type &&value) {
+  return Tree<value_type, void, Comp, Alloc, Stats>::insert_value_(
+      std::move(value));
+}
+
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+inline typename Set<value_type, Comp, Alloc, Stats>::insert_return_type
+Set<value_type, Comp, Alloc, Stats>::insert(node_type &&node) {
+  return Tree<value_type, void, Comp, Alloc, Stats>::insert_node_(
+      std::move(node));
+}
 
-  Tree<value_type, value_type>::push_(value, value);
-  iterator pos = Tree<value_type, value_type>::find_pos_(value);
+// Значение строится сразу в узле; при повторе ключа узел освобождается.
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+template <class... Args>
+inline std::pair<typename Set<value_type, Comp, Alloc, Stats>::iterator, bool>
+Set<value_type, Comp, Alloc, Stats>::emplace(Args &&...args) {
+  return Tree<value_type, void, Comp, Alloc, Stats>::emplace_(
+      std::forward<Args>(args)...);
+}
+
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+void Set<value_type, Comp, Alloc, Stats>::clear() {
+  Tree<value_type, void, Comp, Alloc, Stats>::clear();
+}
 
-  return std::pair<iterator, bool>(pos, true);
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+void Set<value_type, Comp, Alloc, Stats>::erase(iterator pos) {
+  this->Tree<value_type, void, Comp, Alloc, Stats>::erase(pos);
 }
 
-template <typename value_type>
-void Set<value_type>::clear() {
-  Tree<value_type, value_type>::clear();
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+void Set<value_type, Comp, Alloc, Stats>::swap(Set &other) {
+  Tree<value_type, void, Comp, Alloc, Stats>::swap(other);
 }
 
-template <typename value_type>
-void Set<value_type>::erase(iterator pos) {
-  this->Tree<value_type, value_type>::erase(pos);
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+void Set<value_type, Comp, Alloc, Stats>::merge(Set &other) {
+  Tree<value_type, void, Comp, Alloc, Stats>::merge(other);
 }
 
-template <typename value_type>
-void Set<value_type>::swap(Set &other) {
-  Tree<value_type, value_type>::swap(other);
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+typename Set<value_type, Comp, Alloc, Stats>::iterator
+Set<value_type, Comp, Alloc, Stats>::find(const key_type &key) {
+  return Tree<value_type, void, Comp, Alloc, Stats>::find_pos_(key);
 }
 
-template <typename value_type>
-void Set<value_type>::merge(Set &other) {
-  Tree<value_type, value_type>::merge(other);
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+template <typename Key, typename>
+typename Set<value_type, Comp, Alloc, Stats>::iterator
+Set<value_type, Comp, Alloc, Stats>::find(const Key &key) {
+  return Tree<value_type, void, Comp, Alloc, Stats>::find_pos_(key);
 }
 
-template <typename value_type>
-typename Set<value_type>::iterator Set<value_type>::find(const key_type &key) {
-  return Tree<value_type, value_type>::find_pos_(key);
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+bool Set<value_type, Comp, Alloc, Stats>::contains(const key_type &key) {
+  return Tree<value_type, void, Comp, Alloc, Stats>::contains(key);
 }
 
-template <typename value_type>
-bool Set<value_type>::contains(const key_type &key) {
-  return Tree<value_type, value_type>::contains(key);
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
+template <typename Key, typename>
+bool Set<value_type, Comp, Alloc, Stats>::contains(const Key &key) {
+  return Tree<value_type, void, Comp, Alloc, Stats>::contains(key);
 }
 
-template <typename value_type>
+template <typename value_type, typename Comp, typename Alloc, typename Stats>
 template <class... Args>
-Vector<std::pair<typename Set<value_type>::iterator, bool>>
-Set<value_type>::insert_many(Args &&...args) {
-  Vector<std::pair<typename Tree<value_type, value_type>::iterator, bool>> ret;
+Vector<std::pair<typename Set<value_type, Comp, Alloc, Stats>::iterator, bool>>
+Set<value_type, Comp, Alloc, Stats>::insert_many(Args &&...args) {
+  Vector<std::pair<iterator, bool>> ret;
   for (auto arg : {args...}) {
-    if (contains(arg) && !Tree<value_type, value_type>::is_multi_set) {
-      ret.push_back(
-          std::pair(Tree<value_type, value_type>::find_pos_(arg), false));
-    } else {
-      Tree<value_type, value_type>::push_(arg, arg);
-      ret.push_back(
-          std::pair(Tree<value_type, value_type>::find_pos_(arg), true));
-    }
+    ret.push_back(insert(arg));
   }
 
   return ret;
@@ -0,0 +1,79 @@
+#ifndef S21_STATIC_MAP_H
+#define S21_STATIC_MAP_H
+
+#include "../map/map.h"
+#include "../static_tree/static_tree.h"
+
+namespace s21 {
+
+// Read-only map for lookup-heavy data that is built once; see StaticSet.
+// Keys and values share the Eytzinger array, so a hit needs no extra load.
+template <typename K, typename T, typename Comp = std::less<>>
+class StaticMap : public StaticTree<K, T, Comp> {
+ public:
+  using key_type = K;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = size_t;
+  using key_compare = Comp;
+
+  StaticMap() = default;
+  StaticMap(std::initializer_list<value_type> const &items);
+  template <typename Alloc, typename Stats>
+  explicit StaticMap(const Map<K, T, Comp, Alloc, Stats> &map);
+  // items must be sorted by key and contain no duplicate keys.
+  explicit StaticMap(const Vector<std::pair<K, T>> &items);
+
+  const mapped_type &at(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  const mapped_type &at(const Key &key) const;
+};
+
+template <typename K, typename T, typename Comp>
+StaticMap<K, T, Comp>::StaticMap(
+    std::initializer_list<value_type> const &items) {
+  StaticTree<K, T, Comp>::build_unsorted_(items.begin(), items.end());
+}
+
+template <typename K, typename T, typename Comp>
+template <typename Alloc, typename Stats>
+StaticMap<K, T, Comp>::StaticMap(const Map<K, T, Comp, Alloc, Stats> &map)
+    : StaticTree<K, T, Comp>(map.key_comp()) {
+  const auto &tree =
+      static_cast<const typename Map<K, T, Comp, Alloc, Stats>::tree_type &>(
+          map);
+  auto it = tree.begin();
+  StaticTree<K, T, Comp>::build_(tree.size(), [&it]() -> const value_type & {
+    const value_type &value = *it.operator->();
+    ++it;
+    return value;
+  });
+}
+
+template <typename K, typename T, typename Comp>
+StaticMap<K, T, Comp>::StaticMap(const Vector<std::pair<K, T>> &items) {
+  StaticTree<K, T, Comp>::build_sorted_(items.begin(), items.end());
+}
+
+template <typename K, typename T, typename Comp>
+const T &StaticMap<K, T, Comp>::at(const key_type &key) const {
+  auto it = StaticTree<K, T, Comp>::find(key);
+  if (it == StaticTree<K, T, Comp>::end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename K, typename T, typename Comp>
+template <typename Key, typename>
+const T &StaticMap<K, T, Comp>::at(const Key &key) const {
+  auto it = StaticTree<K, T, Comp>::find(key);
+  if (it == StaticTree<K, T, Comp>::end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef S21_STATIC_SET_H
+#define S21_STATIC_SET_H
+
+#include "../set/set.h"
+#include "../static_tree/static_tree.h"
+
+namespace s21 {
+
+// Read-only set for lookup-heavy data that is built once: contains and find
+// walk a cache-aligned Eytzinger array instead of chasing node pointers.
+template <typename Value, typename Comp = std::less<>>
+class StaticSet : public StaticTree<Value, void, Comp> {
+ public:
+  using key_type = Value;
+  using value_type = Value;
+  using size_type = size_t;
+  using key_compare = Comp;
+
+  StaticSet() = default;
+  StaticSet(std::initializer_list<value_type> const &items);
+  template <typename Alloc, typename Stats>
+  explicit StaticSet(const Set<Value, Comp, Alloc, Stats> &set);
+  // items must be sorted by Comp and contain no duplicates.
+  explicit StaticSet(const Vector<value_type> &items);
+};
+
+template <typename Value, typename Comp>
+StaticSet<Value, Comp>::StaticSet(
+    std::initializer_list<value_type> const &items) {
+  StaticTree<Value, void, Comp>::build_unsorted_(items.begin(), items.end());
+}
+
+template <typename Value, typename Comp>
+template <typename Alloc, typename Stats>
+StaticSet<Value, Comp>::StaticSet(const Set<Value, Comp, Alloc, Stats> &set)
+    : StaticTree<Value, void, Comp>(set.key_comp()) {
+  const auto &tree =
+      static_cast<const typename Set<Value, Comp, Alloc, Stats>::tree_type &>(
+          set);
+  auto it = tree.begin();
+  StaticTree<Value, void, Comp>::build_(tree.size(), [&it]() -> const Value & {
+    const Value &value = *it.operator->();
+    ++it;
+    return value;
+  });
+}
+
+template <typename Value, typename Comp>
+StaticSet<Value, Comp>::StaticSet(const Vector<value_type> &items) {
+  StaticTree<Value, void, Comp>::build_sorted_(items.begin(), items.end());
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,459 @@
+#ifndef S21_STATIC_TREE_H
+#define S21_STATIC_TREE_H
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "../tree/tree.h"
+#include "../vector/vector.h"
+
+namespace s21 {
+
+// Неизменяемое дерево поиска в раскладке Эйтцингера: элементы лежат в
+// массиве в порядке обхода в ширину, потомки узла k - узлы 2k и 2k + 1.
+// Индексы начинаются с 1, массив выровнен по кэш-линии, так что все потомки
+// узла на log2(B) уровней ниже (B элементов в линии) занимают одну линию:
+// спуск подгружает ее заранее и делает один переход без ветвлений на
+// уровень. Раскладка значения - как у Tree: V = void дает множество.
+template <typename K, typename V, typename Comp = std::less<>>
+class StaticTree {
+ public:
+  using key_type = K;
+  using mapped_type = typename TreeValueTraits<K, V>::mapped_type;
+  using value_type = typename TreeValueTraits<K, V>::value_type;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+  using key_compare = Comp;
+
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = Iterator;
+
+  StaticTree() noexcept = default;
+  explicit StaticTree(const key_compare &comp) : comp_(comp) {}
+  StaticTree(const StaticTree &other);
+  StaticTree(StaticTree &&other) noexcept;
+  ~StaticTree() { clear(); }
+
+  StaticTree &operator=(const StaticTree &other);
+  StaticTree &operator=(StaticTree &&other) noexcept;
+
+  iterator begin() const noexcept;
+  iterator end() const noexcept;
+
+  bool empty() const noexcept { return size_ == 0; }
+  size_type size() const noexcept { return size_; }
+  key_compare key_comp() const { return comp_; }
+
+  void clear() noexcept;
+  void swap(StaticTree &other) noexcept;
+
+  // Lookups are O(log n) with one cache miss per log2(B) levels. The Key
+  // overloads are enabled when Comp is transparent.
+  iterator find(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  iterator find(const Key &key) const;
+  bool contains(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  bool contains(const Key &key) const;
+  size_type count(const key_type &key) const;
+  iterator lower_bound(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  iterator lower_bound(const Key &key) const;
+  iterator upper_bound(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  iterator upper_bound(const Key &key) const;
+
+  // Обход в порядке ключей; end() - индекс 0.
+  class Iterator {
+   public:
+    Iterator(size_type index, const StaticTree &tree) noexcept
+        : index_(index), tree_(&tree) {}
+
+    bool operator==(const Iterator &other) const {
+      return index_ == other.index_;
+    }
+    bool operator!=(const Iterator &other) const {
+      return index_ != other.index_;
+    }
+    const value_type &operator*() const { return tree_->data_[index_]; }
+    const value_type *operator->() const { return tree_->data_ + index_; }
+
+    Iterator &operator++() noexcept;
+    Iterator operator++(int) noexcept;
+    Iterator &operator--() noexcept;
+    Iterator operator--(int) noexcept;
+
+   private:
+    size_type index_;
+    const StaticTree *tree_;
+  };
+
+ protected:
+  using value_traits = TreeValueTraits<K, V>;
+  using slot_type = std::remove_const_t<value_type>;
+
+  static constexpr size_type kCacheLine = 64;
+  static constexpr size_type kLineSize =
+      sizeof(slot_type) < kCacheLine ? kCacheLine / sizeof(slot_type) : 1;
+
+  // next() возвращает элементы по возрастанию ключей без повторов; они
+  // раскладываются по индексам в порядке симметричного обхода.
+  template <typename Next>
+  void build_(size_type count, Next next);
+  // Произвольный порядок: сортировка указателей, из равных остается первый.
+  template <typename InputIt>
+  void build_unsorted_(InputIt first, InputIt last);
+  // Отсортированный по возрастанию вход без повторов, иначе invalid_argument.
+  // Элемент - ключ множества или пара с ключом в first.
+  template <typename InputIt>
+  void build_sorted_(InputIt first, InputIt last);
+  template <typename Elem>
+  static const key_type &input_key_(const Elem &elem) noexcept;
+
+  template <typename Key>
+  size_type lower_bound_index_(const Key &key) const noexcept;
+  template <typename Key>
+  size_type upper_bound_index_(const Key &key) const noexcept;
+  template <typename Key>
+  size_type find_index_(const Key &key) const noexcept;
+
+  static size_type first_index_(size_type size) noexcept;
+  static size_type last_index_(size_type size) noexcept;
+  static size_type next_index_(size_type index, size_type size) noexcept;
+  static size_type prev_index_(size_type index, size_type size) noexcept;
+  static slot_type *allocate_(size_type size);
+  static void deallocate_(slot_type *data) noexcept;
+
+ private:
+  slot_type *data_ = nullptr;
+  size_type size_ = 0;
+  key_compare comp_;
+};
+
+template <typename K, typename V, typename Comp>
+StaticTree<K, V, Comp>::StaticTree(const StaticTree &other)
+    : comp_(other.comp_) {
+  if (other.size_ == 0) return;
+  slot_type *data = allocate_(other.size_);
+  size_type built = 0;
+  try {
+    for (; built < other.size_; ++built) {
+      ::new (static_cast<void *>(data + built + 1))
+          slot_type(other.data_[built + 1]);
+    }
+  } catch (...) {
+    for (size_type k = 1; k <= built; ++k) data[k].~slot_type();
+    deallocate_(data);
+    throw;
+  }
+  data_ = data;
+  size_ = other.size_;
+}
+
+template <typename K, typename V, typename Comp>
+StaticTree<K, V, Comp>::StaticTree(StaticTree &&other) noexcept
+    : data_(other.data_), size_(other.size_), comp_(other.comp_) {
+  other.data_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename K, typename V, typename Comp>
+StaticTree<K, V, Comp> &StaticTree<K, V, Comp>::operator=(
+    const StaticTree &other) {
+  if (this != &other) {
+    StaticTree copy(other);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename Comp>
+StaticTree<K, V, Comp> &StaticTree<K, V, Comp>::operator=(
+    StaticTree &&other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename Comp>
+inline typename StaticTree<K, V, Comp>::iterator
+StaticTree<K, V, Comp>::begin() const noexcept {
+  return iterator(first_index_(size_), *this);
+}
+
+template <typename K, typename V, typename Comp>
+inline typename StaticTree<K, V, Comp>::iterator StaticTree<K, V, Comp>::end()
+    const noexcept {
+  return iterator(0, *this);
+}
+
+template <typename K, typename V, typename Comp>
+void StaticTree<K, V, Comp>::clear() noexcept {
+  if (data_ == nullptr) return;
+  if constexpr (!std::is_trivially_destructible_v<slot_type>) {
+    for (size_type k = 1; k <= size_; ++k) data_[k].~slot_type();
+  }
+  deallocate_(data_);
+  data_ = nullptr;
+  size_ = 0;
+}
+
+template <typename K, typename V, typename Comp>
+void StaticTree<K, V, Comp>::swap(StaticTree &other) noexcept {
+  std::swap(data_, other.data_);
+  std::swap(size_, other.size_);
+  std::swap(comp_, other.comp_);
+}
+
+template <typename K, typename V, typename Comp>
+inline typename StaticTree<K, V, Comp>::iterator StaticTree<K, V, Comp>::find(
+    const key_type &key) const {
+  return iterator(find_index_(key), *this);
+}
+
+template <typename K, typename V, typename Comp>
+template <typename Key, typename>
+inline typename StaticTree<K, V, Comp>::iterator StaticTree<K, V, Comp>::find(
+    const Key &key) const {
+  return iterator(find_index_(key), *this);
+}
+
+template <typename K, typename V, typename Comp>
+inline bool StaticTree<K, V, Comp>::contains(const key_type &key) const {
+  return find_index_(key) != 0;
+}
+
+template <typename K, typename V, typename Comp>
+template <typename Key, typename>
+inline bool StaticTree<K, V, Comp>::contains(const Key &key) const {
+  return find_index_(key) != 0;
+}
+
+template <typename K, typename V, typename Comp>
+inline typename StaticTree<K, V, Comp>::size_type
+StaticTree<K, V, Comp>::count(const key_type &key) const {
+  return find_index_(key) != 0 ? 1 : 0;
+}
+
+template <typename K, typename V, typename Comp>
+inline typename StaticTree<K, V, Comp>::iterator
+StaticTree<K, V, Comp>::lower_bound(const key_type &key) const {
+  return iterator(lower_bound_index_(key), *this);
+}
+
+template <typename K, typename V, typename Comp>
+template <typename Key, typename>
+inline typename StaticTree<K, V, Comp>::iterator
+StaticTree<K, V, Comp>::lower_bound(const Key &key) const {
+  return iterator(lower_bound_index_(key), *this);
+}
+
+template <typename K, typename V, typename Comp>
+inline typename StaticTree<K, V, Comp>::iterator
+StaticTree<K, V, Comp>::upper_bound(const key_type &key) const {
+  return iterator(upper_bound_index_(key), *this);
+}
+
+template <typename K, typename V, typename Comp>
+template <typename Key, typename>
+inline typename StaticTree<K, V, Comp>::iterator
+StaticTree<K, V, Comp>::upper_bound(const Key &key) const {
+  return iterator(upper_bound_index_(key), *this);
+}
+
+template <typename K, typename V, typename Comp>
+inline typename StaticTree<K, V, Comp>::Iterator &
+StaticTree<K, V, Comp>::Iterator::operator++() noexcept {
+  index_ = next_index_(index_, tree_->size_);
+  return *this;
+}
+
+template <typename K, typename V, typename Comp>
+inline typename StaticTree<K, V, Comp>::Iterator
+StaticTree<K, V, Comp>::Iterator::operator++(int) noexcept {
+  Iterator tmp(*this);
+  index_ = next_index_(index_, tree_->size_);
+  return tmp;
+}
+
+template <typename K, typename V, typename Comp>
+inline typename StaticTree<K, V, Comp>::Iterator &
+StaticTree<K, V, Comp>::Iterator::operator--() noexcept {
+  index_ = prev_index_(index_, tree_->size_);
+  return *this;
+}
+
+template <typename K, typename V, typename Comp>
+inline typename StaticTree<K, V, Comp>::Iterator
+StaticTree<K, V, Comp>::Iterator::operator--(int) noexcept {
+  Iterator tmp(*this);
+  index_ = prev_index_(index_, tree_->size_);
+  return tmp;
+}
+
+template <typename K, typename V, typename Comp>
+template <typename Next>
+void StaticTree<K, V, Comp>::build_(size_type count, Next next) {
+  clear();
+  if (count == 0) return;
+  slot_type *data = allocate_(count);
+  size_type built = 0;
+  try {
+    for (size_type k = first_index_(count); k != 0;
+         k = next_index_(k, count), ++built) {
+      ::new (static_cast<void *>(data + k)) slot_type(next());
+    }
+  } catch (...) {
+    for (size_type k = first_index_(count); built > 0;
+         k = next_index_(k, count), --built) {
+      data[k].~slot_type();
+    }
+    deallocate_(data);
+    throw;
+  }
+  data_ = data;
+  size_ = count;
+}
+
+template <typename K, typename V, typename Comp>
+template <typename InputIt>
+void StaticTree<K, V, Comp>::build_unsorted_(InputIt first, InputIt last) {
+  Vector<const value_type *> values;
+  for (; first != last; ++first) values.push_back(&*first);
+  std::stable_sort(values.begin(), values.end(),
+                   [this](const value_type *a, const value_type *b) {
+                     return comp_(value_traits::key(*a), value_traits::key(*b));
+                   });
+  auto unique_end = std::unique(
+      values.begin(), values.end(),
+      [this](const value_type *a, const value_type *b) {
+        return !comp_(value_traits::key(*a), value_traits::key(*b));
+      });
+  const value_type **it = values.begin();
+  build_(static_cast<size_type>(unique_end - values.begin()),
+         [&it]() -> const value_type & { return **it++; });
+}
+
+template <typename K, typename V, typename Comp>
+template <typename InputIt>
+void StaticTree<K, V, Comp>::build_sorted_(InputIt first, InputIt last) {
+  for (InputIt prev = first, it = first; it != last; prev = it) {
+    if (++it != last &&
+        !comp_(input_key_(*prev), input_key_(*it))) {
+      throw std::invalid_argument("Input is not sorted or has duplicates");
+    }
+  }
+  build_(static_cast<size_type>(std::distance(first, last)),
+         [&first]() -> decltype(*first) { return *first++; });
+}
+
+template <typename K, typename V, typename Comp>
+template <typename Elem>
+inline const K &StaticTree<K, V, Comp>::input_key_(const Elem &elem) noexcept {
+  if constexpr (std::is_void_v<V>) {
+    return elem;
+  } else {
+    return elem.first;
+  }
+}
+
+// Спуск идет вправо, пока ключ узла меньше искомого: после выхода за лист
+// номер нужного узла - k без хвостовых единиц и еще одного бита.
+template <typename K, typename V, typename Comp>
+template <typename Key>
+typename StaticTree<K, V, Comp>::size_type
+StaticTree<K, V, Comp>::lower_bound_index_(const Key &key) const noexcept {
+  size_type k = 1;
+  while (k <= size_) {
+    __builtin_prefetch(data_ + k * kLineSize);
+    k = 2 * k + comp_(value_traits::key(data_[k]), key);
+  }
+  return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+}
+
+template <typename K, typename V, typename Comp>
+template <typename Key>
+typename StaticTree<K, V, Comp>::size_type
+StaticTree<K, V, Comp>::upper_bound_index_(const Key &key) const noexcept {
+  size_type k = 1;
+  while (k <= size_) {
+    __builtin_prefetch(data_ + k * kLineSize);
+    k = 2 * k + !comp_(key, value_traits::key(data_[k]));
+  }
+  return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+}
+
+template <typename K, typename V, typename Comp>
+template <typename Key>
+inline typename StaticTree<K, V, Comp>::size_type
+StaticTree<K, V, Comp>::find_index_(const Key &key) const noexcept {
+  size_type k = lower_bound_index_(key);
+  if (k != 0 && comp_(key, value_traits::key(data_[k]))) k = 0;
+  return k;
+}
+
+template <typename K, typename V, typename Comp>
+inline typename StaticTree<K, V, Comp>::size_type
+StaticTree<K, V, Comp>::first_index_(size_type size) noexcept {
+  size_type k = size == 0 ? 0 : 1;
+  while (k != 0 && 2 * k <= size) k = 2 * k;
+  return k;
+}
+
+template <typename K, typename V, typename Comp>
+inline typename StaticTree<K, V, Comp>::size_type
+StaticTree<K, V, Comp>::last_index_(size_type size) noexcept {
+  size_type k = size == 0 ? 0 : 1;
+  while (k != 0 && 2 * k + 1 <= size) k = 2 * k + 1;
+  return k;
+}
+
+// Следующий по порядку: самый левый узел правого поддерева, иначе первый
+// предок, для которого мы в левом поддереве. Для последнего узла - 0.
+template <typename K, typename V, typename Comp>
+typename StaticTree<K, V, Comp>::size_type
+StaticTree<K, V, Comp>::next_index_(size_type index, size_type size) noexcept {
+  if (index == 0) return first_index_(size);
+  if (2 * index + 1 <= size) {
+    index = 2 * index + 1;
+    while (2 * index <= size) index = 2 * index;
+    return index;
+  }
+  while (index & 1) index >>= 1;
+  return index >> 1;
+}
+
+template <typename K, typename V, typename Comp>
+typename StaticTree<K, V, Comp>::size_type
+StaticTree<K, V, Comp>::prev_index_(size_type index, size_type size) noexcept {
+  if (index == 0) return last_index_(size);
+  if (2 * index <= size) {
+    index = 2 * index;
+    while (2 * index + 1 <= size) index = 2 * index + 1;
+    return index;
+  }
+  while (index != 0 && !(index & 1)) index >>= 1;
+  return index >> 1;
+}
+
+template <typename K, typename V, typename Comp>
+inline typename StaticTree<K, V, Comp>::slot_type *
+StaticTree<K, V, Comp>::allocate_(size_type size) {
+  return static_cast<slot_type *>(::operator new(
+      (size + 1) * sizeof(slot_type), std::align_val_t(kCacheLine)));
+}
+
+template <typename K, typename V, typename Comp>
+inline void StaticTree<K, V, Comp>::deallocate_(slot_type *data) noexcept {
+  ::operator delete(data, std::align_val_t(kCacheLine));
+}
+
+}  // namespace s21
+
+#endif
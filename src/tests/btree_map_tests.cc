@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include "tests.h"
+
+using SmallBTreeMap =
+    s21::BTreeMap<int, std::string, std::less<>,
+                  std::allocator<std::pair<const int, std::string>>, 64>;
+
+TEST(BTreeMap, RandomAgainstStdMap) {
+  SmallBTreeMap map;
+  std::map<int, std::string> std;
+  unsigned seed = 11;
+  for (int step = 0; step < 20000; ++step) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>(seed >> 16) % 700;
+    if (step % 4 == 3) {
+      auto it = map.find(key);
+      ASSERT_EQ(it != map.end(), std.erase(key) == 1);
+      if (it != map.end()) map.erase(it);
+    } else {
+      std::string value = std::to_string(step);
+      ASSERT_EQ(map.insert_or_assign(key, value).second,
+                std.insert_or_assign(key, value).second);
+    }
+  }
+  ASSERT_EQ(map.size(), std.size());
+  auto it = map.begin();
+  for (const auto &item : std) {
+    ASSERT_EQ(it->first, item.first);
+    ASSERT_EQ(it->second, item.second);
+    ++it;
+  }
+  ASSERT_TRUE(it == map.end());
+  SmallBTreeMap copy(map);
+  for (const auto &item : std) ASSERT_EQ(copy.at(item.first), item.second);
+}
+
+TEST(BTreeMap, Interface) {
+  s21::BTreeMap<std::string, int> map = {{"one", 1}, {"two", 2}};
+  ASSERT_EQ(map.at("one"), 1);
+  ASSERT_EQ(map.at(std::string_view("two")), 2);
+  ASSERT_THROW(map.at("three"), std::out_of_range);
+  map["three"] = 3;
+  ASSERT_EQ(map.size(), 3);
+  ASSERT_FALSE(map.insert("one", 10).second);
+  ASSERT_EQ(map["one"], 1);
+  ASSERT_FALSE(map.insert_or_assign("one", 10).second);
+  ASSERT_EQ(map["one"], 10);
+  ASSERT_TRUE(map.try_emplace("four", 4).second);
+  ASSERT_FALSE(map.try_emplace("four", 40).second);
+  ASSERT_TRUE(map.emplace("five", 5).second);
+  ASSERT_TRUE(map.contains(std::string_view("five")));
+  ASSERT_EQ(map.lower_bound("g")->first, "one");
+  map.erase(map.find("one"));
+  ASSERT_FALSE(map.contains("one"));
+  auto results = map.insert_many(std::pair<const std::string, int>{"six", 6},
+                                 std::pair<const std::string, int>{"two", 0});
+  ASSERT_TRUE(results[0].second);
+  ASSERT_FALSE(results[1].second);
+  ASSERT_EQ(results[1].first->second, 2);
+  ASSERT_EQ(map.size(), 5);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "tests.h"
+
+// 16-байтные узлы: по 4 int, так что даже сотня ключей дает несколько
+// уровней и все ветки деления, займа и слияния.
+using SmallBTreeSet = s21::BTreeSet<int, std::less<>, std::allocator<int>, 16>;
+
+static void ExpectSameSet(const SmallBTreeSet &set, const std::set<int> &std) {
+  ASSERT_EQ(set.size(), std.size());
+  auto it = set.begin();
+  for (int key : std) {
+    ASSERT_EQ(*it, key);
+    ++it;
+  }
+  ASSERT_TRUE(it == set.end());
+  for (auto rit = std.rbegin(); rit != std.rend(); ++rit) {
+    ASSERT_EQ(*--it, *rit);
+  }
+}
+
+TEST(BTreeSet, RandomAgainstStdSet) {
+  SmallBTreeSet set;
+  std::set<int> std;
+  unsigned seed = 7;
+  for (int step = 0; step < 20000; ++step) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>(seed >> 16) % 500;
+    if (step % 3 == 2) {
+      auto it = set.find(key);
+      ASSERT_EQ(it != set.end(), std.erase(key) == 1);
+      if (it != set.end()) set.erase(it);
+    } else {
+      ASSERT_EQ(set.insert(key).second, std.insert(key).second);
+    }
+    if (step % 1000 == 0) ExpectSameSet(set, std);
+  }
+  ExpectSameSet(set, std);
+  for (int key = -1; key <= 500; ++key) {
+    ASSERT_EQ(set.contains(key), std.count(key) == 1);
+    auto lower = std.lower_bound(key);
+    auto it = set.lower_bound(key);
+    ASSERT_EQ(it == set.end(), lower == std.end());
+    if (lower != std.end()) {
+      ASSERT_EQ(*it, *lower);
+    }
+    auto upper = std.upper_bound(key);
+    it = set.upper_bound(key);
+    ASSERT_EQ(it == set.end(), upper == std.end());
+    if (upper != std.end()) {
+      ASSERT_EQ(*it, *upper);
+    }
+  }
+  while (!set.empty()) set.erase(set.begin());
+  ASSERT_TRUE(set.begin() == set.end());
+}
+
+TEST(BTreeSet, SortedInsertAndErase) {
+  SmallBTreeSet set;
+  std::set<int> std;
+  for (int i = 0; i < 1000; ++i) {
+    set.insert(i);
+    std.insert(i);
+  }
+  ExpectSameSet(set, std);
+  for (int i = 999; i >= 0; i -= 2) {
+    set.erase(set.find(i));
+    std.erase(i);
+  }
+  ExpectSameSet(set, std);
+}
+
+TEST(BTreeSet, Interface) {
+  s21::BTreeSet<int> set = {5, 1, 4, 1, 3};
+  ASSERT_EQ(set.size(), 4);
+  ASSERT_EQ(*set.begin(), 1);
+  ASSERT_FALSE(set.insert(4).second);
+  ASSERT_TRUE(set.emplace(2).second);
+  ASSERT_EQ(set.count(2), 1);
+  auto range = set.equal_range(3);
+  ASSERT_EQ(*range.first, 3);
+  ASSERT_EQ(*range.second, 4);
+  auto results = set.insert_many(7, 5, 6);
+  ASSERT_EQ(results.size(), 3);
+  ASSERT_TRUE(results[0].second);
+  ASSERT_FALSE(results[1].second);
+  ASSERT_EQ(*results[0].first, 7);
+  ASSERT_EQ(*results[2].first, 6);
+  ASSERT_EQ(set.size(), 7);
+  set.clear();
+  ASSERT_TRUE(set.empty());
+}
+
+TEST(BTreeSet, StringsCopyMoveMerge) {
+  s21::BTreeSet<std::string> set;
+  for (int i = 0; i < 300; ++i) set.insert(std::to_string(i));
+  s21::BTreeSet<std::string> copy = set;
+  s21::BTreeSet<std::string> moved = std::move(set);
+  ASSERT_TRUE(set.empty());
+  ASSERT_EQ(copy.size(), 300);
+  ASSERT_TRUE(copy.contains(std::string_view("299")));
+  ASSERT_EQ(*moved.begin(), "0");
+
+  s21::BTreeSet<std::string> other = {"0", "a", "b"};
+  moved.merge(other);
+  ASSERT_EQ(moved.size(), 302);
+  ASSERT_EQ(other.size(), 1);
+  ASSERT_EQ(*other.begin(), "0");
+  copy = moved;
+  ASSERT_EQ(copy.size(), 302);
+  ASSERT_EQ(*--copy.end(), "b");
+}
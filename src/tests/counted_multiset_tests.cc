@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include "tests.h"
+
+TEST(CountedMultiset, IterateCopies) {
+  s21::CountedMultiset<int> counted = {3, 1, 3, 2, 3, 1};
+  std::multiset<int> expected = {3, 1, 3, 2, 3, 1};
+  ASSERT_EQ(counted.size(), expected.size());
+  ASSERT_EQ(counted.distinct_size(), 3);
+  auto it = counted.begin();
+  for (int value : expected) ASSERT_EQ(*it++, value);
+  ASSERT_TRUE(it == counted.end());
+  for (auto rit = expected.rbegin(); rit != expected.rend(); ++rit) {
+    ASSERT_EQ(*--it, *rit);
+  }
+  ASSERT_TRUE(it == counted.begin());
+}
+
+TEST(CountedMultiset, InsertEraseCount) {
+  s21::CountedMultiset<int> counted;
+  for (int i = 0; i < 10000; ++i) counted.insert(i % 4);
+  auto pos = counted.insert(7, 5);
+  ASSERT_EQ(*pos, 7);
+  ASSERT_EQ(counted.size(), 10005);
+  ASSERT_EQ(counted.distinct_size(), 5);
+  ASSERT_EQ(counted.count(2), 2500);
+  ASSERT_EQ(counted.count(5), 0);
+
+  counted.erase(counted.find(2));
+  ASSERT_EQ(counted.count(2), 2499);
+  ASSERT_EQ(counted.erase(1), 2500);
+  ASSERT_FALSE(counted.contains(1));
+  ASSERT_EQ(counted.size(), 7504);
+  for (int i = 0; i < 5; ++i) counted.erase(counted.find(7));
+  ASSERT_FALSE(counted.contains(7));
+  ASSERT_EQ(counted.distinct_size(), 3);
+}
+
+TEST(CountedMultiset, BoundsAndRange) {
+  s21::CountedMultiset<std::string> counted = {"b", "a", "b", "c", "b"};
+  auto range = counted.equal_range("b");
+  ASSERT_EQ(*range.first, "b");
+  ASSERT_EQ(*range.second, "b");
+  ASSERT_EQ(*(++range.second), "c");
+  ASSERT_EQ(*(--range.first), "a");
+  ASSERT_EQ(*counted.lower_bound("b"), "b");
+  ASSERT_EQ(*counted.upper_bound("b"), "c");
+  ASSERT_TRUE(counted.upper_bound("c") == counted.end());
+  auto missing = counted.equal_range("d");
+  ASSERT_TRUE(missing.first == counted.end());
+  ASSERT_TRUE(missing.second == counted.end());
+}
+
+TEST(CountedMultiset, CopyMoveMerge) {
+  s21::CountedMultiset<int> a = {1, 1, 2};
+  s21::CountedMultiset<int> b = {2, 3, 3};
+  s21::CountedMultiset<int> copy = a;
+  a.merge(b);
+  ASSERT_TRUE(b.empty());
+  ASSERT_EQ(a.size(), 6);
+  ASSERT_EQ(a.count(2), 2);
+  ASSERT_EQ(copy.size(), 3);
+
+  s21::CountedMultiset<int> moved = std::move(a);
+  ASSERT_EQ(moved.size(), 6);
+  ASSERT_EQ(a.size(), 0);
+  moved.swap(copy);
+  ASSERT_EQ(moved.size(), 3);
+  ASSERT_EQ(copy.count(3), 2);
+  copy.clear();
+  ASSERT_TRUE(copy.empty());
+  ASSERT_TRUE(copy.begin() == copy.end());
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include "tests.h"
+
+namespace {
+
+// Копия ключа 2 бросает исключение.
+struct FragileKey {
+  explicit FragileKey(int v) : value(v) {}
+  FragileKey(const FragileKey &other) : value(other.value) {
+    if (value == 2) throw std::runtime_error("copy");
+  }
+  FragileKey &operator=(const FragileKey &other) = default;
+  bool operator<(const FragileKey &other) const { return value < other.value; }
+  int value;
+};
+
+}  // namespace
+
+TEST(FlatMap, Interface) {
+  s21::FlatMap<int, double> map = {{3, 0.3}, {1, 0.1}, {2, 0.2}, {1, 9.9}};
+  ASSERT_EQ(map.size(), 3);
+  ASSERT_EQ(map.at(1), 0.1);
+  ASSERT_THROW(map.at(4), std::out_of_range);
+  map[4] = 0.4;
+  ASSERT_FALSE(map.insert(4, 1.0).second);
+  ASSERT_FALSE(map.insert_or_assign(4, 1.0).second);
+  ASSERT_EQ(map[4], 1.0);
+  ASSERT_TRUE(map.try_emplace(0, 0.0).second);
+  ASSERT_TRUE(map.emplace(7, 0.7).second);
+  ASSERT_EQ(map.lower_bound(5)->first, 7);
+  ASSERT_TRUE(map.upper_bound(7) == map.end());
+  map.erase(map.find(2));
+  ASSERT_FALSE(map.contains(2));
+
+  int keys[] = {0, 1, 3, 4, 7};
+  auto it = map.begin();
+  for (int key : keys) {
+    ASSERT_EQ(it->first, key);
+    ++it;
+  }
+  ASSERT_TRUE(it == map.end());
+  ASSERT_EQ((--it)->second, 0.7);
+}
+
+TEST(FlatMap, InsertManyMergesOnce) {
+  s21::FlatMap<int, int> map = {{10, 1}, {20, 2}};
+  auto results = map.insert_many(std::pair<const int, int>{15, 3},
+                                 std::pair<const int, int>{20, 4},
+                                 std::pair<const int, int>{5, 5},
+                                 std::pair<const int, int>{15, 6});
+  ASSERT_EQ(results.size(), 4);
+  ASSERT_TRUE(results[0].second);
+  ASSERT_FALSE(results[1].second);
+  ASSERT_TRUE(results[2].second);
+  ASSERT_FALSE(results[3].second);
+  ASSERT_EQ(results[1].first->second, 2);
+  ASSERT_EQ(results[3].first->second, 3);
+  ASSERT_EQ(map.size(), 4);
+  int expected[][2] = {{5, 5}, {10, 1}, {15, 3}, {20, 2}};
+  auto it = map.begin();
+  for (auto &item : expected) {
+    ASSERT_EQ(it->first, item[0]);
+    ASSERT_EQ(it->second, item[1]);
+    ++it;
+  }
+}
+
+TEST(FlatMap, AgainstStdMap) {
+  std::map<int, int> std;
+  unsigned seed = 5;
+  std::vector<std::pair<int, int>> items;
+  for (int i = 0; i < 3000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    items.push_back({static_cast<int>(seed >> 16) % 2000, i});
+    std.insert(items.back());
+  }
+  s21::FlatMap<int, int> map(items.begin(), items.end());
+  s21::FlatMap<int, int> copy;
+  for (const auto &item : items) copy.insert(item.first, item.second);
+  ASSERT_EQ(map.size(), std.size());
+  ASSERT_EQ(copy.size(), std.size());
+  for (const auto &item : std) {
+    ASSERT_EQ(map.at(item.first), item.second);
+    ASSERT_EQ(copy.at(item.first), item.second);
+  }
+
+  s21::FlatMap<int, int> other = {{-1, 0}, {items[0].first, -5}};
+  copy = map;
+  map.merge(other);
+  ASSERT_EQ(map.size(), copy.size() + 1);
+  ASSERT_EQ(other.size(), 1);
+  ASSERT_EQ(other.begin()->second, -5);
+  ASSERT_EQ(map.begin()->first, -1);
+}
+
+TEST(FlatMap, StringKeysAndValues) {
+  s21::FlatMap<std::string, std::string> map;
+  for (int i = 0; i < 300; ++i) {
+    map.insert(std::to_string(i * 7 % 300), std::string(40, 'v'));
+  }
+  ASSERT_EQ(map.size(), 300);
+  map.insert_or_assign("150", "changed");
+  ASSERT_EQ(map.at("150"), "changed");
+  map.erase(map.find("0"));
+  ASSERT_EQ(map.begin()->first, "1");
+  s21::FlatMap<std::string, std::string> copy(map);
+  ASSERT_EQ(copy.at("299"), std::string(40, 'v'));
+}
+
+TEST(FlatMap, ThrowingKeyLeavesMapIntact) {
+  s21::FlatMap<FragileKey, int> map;
+  map.insert(FragileKey(1), 10);
+  map.insert(FragileKey(3), 30);
+  ASSERT_THROW(map.insert(FragileKey(2), 20), std::runtime_error);
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_EQ(map.at(FragileKey(1)), 10);
+  ASSERT_EQ(map.at(FragileKey(3)), 30);
+}
+
+TEST(FlatMap, MoveOnlyValues) {
+  s21::FlatMap<std::string, std::unique_ptr<int>> map;
+  std::string key = "b";
+  map[std::move(key)] = std::make_unique<int>(2);
+  ASSERT_TRUE(map.try_emplace("a", std::make_unique<int>(1)).second);
+  ASSERT_TRUE(map.insert({"c", std::make_unique<int>(3)}).second);
+  ASSERT_FALSE(map.insert_or_assign("c", std::make_unique<int>(4)).second);
+  ASSERT_TRUE(map.emplace("d", std::make_unique<int>(5)).second);
+  ASSERT_EQ(map.size(), 4);
+  ASSERT_EQ(*map.at("a"), 1);
+  ASSERT_EQ(*map.at("b"), 2);
+  ASSERT_EQ(*map.at("c"), 4);
+  ASSERT_EQ(*map.at("d"), 5);
+}
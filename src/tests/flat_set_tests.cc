@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include "tests.h"
+
+TEST(FlatSet, Interface) {
+  s21::FlatSet<int> set = {5, 1, 4, 1, 3};
+  ASSERT_EQ(set.size(), 4);
+  ASSERT_EQ(*set.begin(), 1);
+  ASSERT_FALSE(set.insert(4).second);
+  ASSERT_TRUE(set.emplace(2).second);
+  ASSERT_EQ(*set.insert(0).first, 0);
+  ASSERT_EQ(set.count(2), 1);
+  auto range = set.equal_range(3);
+  ASSERT_EQ(*range.first, 3);
+  ASSERT_EQ(*range.second, 4);
+  set.erase(set.find(3));
+  ASSERT_FALSE(set.contains(3));
+  int expected = 0;
+  for (auto it = set.begin(); it != set.end(); ++it, ++expected) {
+    if (expected == 3) ++expected;
+    ASSERT_EQ(*it, expected);
+  }
+  set.clear();
+  ASSERT_TRUE(set.empty());
+}
+
+TEST(FlatSet, InsertManyAndMerge) {
+  s21::FlatSet<int> set;
+  auto results = set.insert_many(9, 3, 9, 6);
+  ASSERT_TRUE(results[0].second);
+  ASSERT_TRUE(results[1].second);
+  ASSERT_FALSE(results[2].second);
+  ASSERT_EQ(*results[2].first, 9);
+  ASSERT_EQ(set.size(), 3);
+  s21::FlatSet<int> other = {1, 6, 12};
+  set.merge(other);
+  ASSERT_EQ(set.size(), 5);
+  ASSERT_EQ(other.size(), 1);
+  ASSERT_EQ(*other.begin(), 6);
+  s21::FlatSet<int> copy(set);
+  ASSERT_EQ(*--copy.end(), 12);
+  ASSERT_EQ(*copy.lower_bound(4), 6);
+}
+
+TEST(FlatSet, CustomCompare) {
+  s21::FlatSet<int, std::greater<int>> set = {1, 3, 2};
+  ASSERT_EQ(*set.begin(), 3);
+  ASSERT_EQ(*set.lower_bound(5), 3);
+  ASSERT_TRUE(set.contains(2));
+}
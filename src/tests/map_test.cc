@@ -286,4 +286,306 @@ TEST(TestMap, InsertManyMap) {
   for (; my_it != my_map.end(); ++my_it, ++reference_it) {
     ASSERT_TRUE(*reference_it == *my_it);
   }
-}
\ No newline at end of file
+}
+TEST(TestMap, Subtest_Insert_Iterator) {
+  // Arrange
+  s21::Map<int, std::string> a;
+  for (int i = 0; i < 100; i += 2) {
+    a.insert(i, std::to_string(i));
+  }
+
+  // Act
+  auto inserted = a.insert(51, "51");
+  auto existing = a.insert(50, "fifty");
+
+  // Assert
+  ASSERT_TRUE(inserted.second);
+  ASSERT_EQ(inserted.first->first, 51);
+  ASSERT_EQ((++inserted.first)->first, 52);
+  ASSERT_FALSE(existing.second);
+  ASSERT_EQ(existing.first->second, "50");
+  ASSERT_EQ(a.size(), 51);
+}
+
+TEST(TestMap, Subtest_Operator_At_3) {
+  // Arrange
+  s21::Map<int, int> a;
+
+  // Act
+  for (int i = 0; i < 1000; ++i) {
+    a[i % 100] += 1;
+  }
+
+  // Assert
+  ASSERT_EQ(a.size(), 100);
+  for (auto it = a.begin(); it != a.end(); ++it) {
+    ASSERT_EQ(it->second, 10);
+  }
+}
+
+namespace {
+struct CountingValue {
+  static int constructed;
+  static int copied;
+  int value;
+
+  explicit CountingValue(int v = 0) : value(v) { ++constructed; }
+  CountingValue(const CountingValue &other) : value(other.value) {
+    ++copied;
+  }
+  CountingValue(CountingValue &&other) noexcept : value(other.value) {}
+  CountingValue &operator=(const CountingValue &other) {
+    value = other.value;
+    ++copied;
+    return *this;
+  }
+  CountingValue &operator=(CountingValue &&other) noexcept {
+    value = other.value;
+    return *this;
+  }
+};
+int CountingValue::constructed = 0;
+int CountingValue::copied = 0;
+}  // namespace
+
+TEST(TestMap, Subtest_Try_Emplace_1) {
+  // Arrange
+  s21::Map<int, CountingValue> a;
+  CountingValue::constructed = 0;
+  CountingValue::copied = 0;
+
+  // Act
+  auto first = a.try_emplace(1, 10);
+  auto second = a.try_emplace(1, 20);
+
+  // Assert
+  ASSERT_TRUE(first.second);
+  ASSERT_FALSE(second.second);
+  ASSERT_EQ(a.at(1).value, 10);
+  ASSERT_EQ(CountingValue::constructed, 1);
+  ASSERT_EQ(CountingValue::copied, 0);
+}
+
+TEST(TestMap, Subtest_Emplace_1) {
+  // Arrange
+  s21::Map<std::string, std::unique_ptr<int>> a;
+
+  // Act
+  auto first = a.emplace("one", std::make_unique<int>(1));
+  auto second = a.emplace("one", std::make_unique<int>(2));
+  a.try_emplace("two", new int(2));
+  a["three"] = std::make_unique<int>(3);
+
+  // Assert
+  ASSERT_TRUE(first.second);
+  ASSERT_FALSE(second.second);
+  ASSERT_EQ(a.size(), 3);
+  ASSERT_EQ(*a.at("one"), 1);
+  ASSERT_EQ(*a.at("two"), 2);
+  ASSERT_EQ(*a.at("three"), 3);
+}
+
+TEST(TestMap, Subtest_Insert_Rvalue) {
+  // Arrange
+  s21::Map<int, std::string> a;
+  std::string heavy(100, 'a');
+
+  // Act
+  auto result = a.insert({1, std::move(heavy)});
+  a.insert_or_assign(1, std::string(50, 'b'));
+
+  // Assert
+  ASSERT_TRUE(result.second);
+  ASSERT_EQ(a.at(1), std::string(50, 'b'));
+}
+
+TEST(TestMap, Subtest_Extract_1) {
+  // Arrange
+  s21::Map<int, std::string> a{{1, "one"}, {2, "two"}, {3, "three"}};
+  s21::Map<int, std::string> b(a.get_allocator());
+  const std::string *address = &a.at(2);
+
+  // Act
+  auto node = a.extract(2);
+  auto missing = a.extract(5);
+  auto result = b.insert(std::move(node));
+
+  // Assert
+  ASSERT_TRUE(missing.empty());
+  ASSERT_TRUE(node.empty());
+  ASSERT_TRUE(result.inserted);
+  ASSERT_TRUE(result.node.empty());
+  ASSERT_EQ(&result.position->second, address);
+  ASSERT_EQ(a.size(), 2);
+  ASSERT_FALSE(a.contains(2));
+  ASSERT_EQ(b.at(2), "two");
+}
+
+TEST(TestMap, Subtest_Extract_2) {
+  // Arrange
+  s21::Map<int, std::string> a{{1, "one"}, {2, "two"}};
+  s21::Map<int, std::string> b{{2, "deux"}};
+
+  // Act
+  auto node = a.extract(a.begin());
+  auto first = b.insert(std::move(node));
+  node = a.extract(2);
+  auto second = b.insert(std::move(node));
+
+  // Assert
+  ASSERT_TRUE(first.inserted);
+  ASSERT_FALSE(second.inserted);
+  ASSERT_EQ(second.node.key(), 2);
+  ASSERT_EQ(second.node.mapped(), "two");
+  ASSERT_EQ(second.position->second, "deux");
+  ASSERT_TRUE(a.empty());
+  ASSERT_EQ(b.size(), 2);
+  ASSERT_EQ(b.at(1), "one");
+}
+
+TEST(TestMap, Subtest_Merge_2) {
+  // Arrange
+  s21::Map<int, int> a;
+  s21::Map<int, int> b;
+  for (int i = 0; i < 1000; ++i) {
+    (i % 2 == 0 ? a : b).insert(i, i * 10);
+  }
+  b.insert(0, -1);
+  const int *address = &b.at(999);
+
+  // Act
+  a.merge(b);
+
+  // Assert
+  ASSERT_EQ(a.size(), 1000);
+  ASSERT_EQ(b.size(), 1);
+  ASSERT_EQ(&a.at(999), address);
+  ASSERT_EQ(a.at(0), 0);
+  ASSERT_EQ(b.at(0), -1);
+  int expected = 0;
+  for (auto it = a.begin(); it != a.end(); ++it, ++expected) {
+    ASSERT_EQ(it->second, expected * 10);
+  }
+  b.insert(5000, 1);
+  b.clear();
+  ASSERT_EQ(a.at(999), 9990);
+}
+
+TEST(TestMap, Subtest_Set_Algebra) {
+  // Arrange
+  s21::Map<std::string, int> a{{"age", 18}, {"height", 180}, {"weight", 80}};
+  s21::Map<std::string, int> b{{"depth", 10}, {"height", 176}};
+
+  // Act
+  auto united = s21::set_union(a, b);
+  auto common = s21::set_intersection(a, b);
+  auto only_b = s21::set_difference(b, a);
+
+  // Assert
+  ASSERT_EQ(united.size(), 4);
+  ASSERT_EQ(united.at("height"), 180);
+  ASSERT_EQ(united.at("depth"), 10);
+  ASSERT_EQ(common.size(), 1);
+  ASSERT_EQ(common.at("height"), 180);
+  ASSERT_EQ(only_b.size(), 1);
+  ASSERT_EQ(only_b.at("depth"), 10);
+}
+
+TEST(TestMap, Subtest_Bounds_1) {
+  // Arrange
+  s21::Map<int, std::string> a;
+  for (int t = 0; t < 1000; t += 10) {
+    a.insert(t, std::to_string(t));
+  }
+
+  // Act
+  auto first = a.lower_bound(95);
+  auto last = a.upper_bound(130);
+  int visited = 0;
+  for (auto it = first; it != last; ++it) ++visited;
+
+  // Assert
+  ASSERT_EQ(first->first, 100);
+  ASSERT_EQ(last->first, 140);
+  ASSERT_EQ(visited, 4);
+  ASSERT_EQ(a.lower_bound(100)->first, 100);
+  ASSERT_EQ(a.upper_bound(100)->first, 110);
+  ASSERT_TRUE(a.lower_bound(991) == a.end());
+  ASSERT_TRUE(a.upper_bound(-1) == a.begin());
+}
+
+TEST(TestMap, Subtest_Equal_Range_1) {
+  // Arrange
+  s21::Map<std::string, int> a{{"age", 18}, {"height", 180}, {"weight", 80}};
+
+  // Act
+  auto found = a.equal_range("height");
+  auto missing = a.equal_range("depth");
+
+  // Assert
+  ASSERT_EQ(found.first->second, 180);
+  ASSERT_EQ(found.second->first, "weight");
+  ASSERT_TRUE(missing.first == missing.second);
+  ASSERT_EQ(missing.first->first, "height");
+  ASSERT_EQ(a.count("age"), 1);
+  ASSERT_EQ(a.count("depth"), 0);
+}
+
+TEST(TestMap, Subtest_Order_Statistics_1) {
+  // Arrange
+  s21::Map<int, std::string, std::less<>,
+           s21::SlabAllocator<std::pair<const int, std::string>>,
+           s21::OrderStatistics>
+      a;
+  for (int t = 0; t < 1000; t += 10) {
+    a.insert(t, std::to_string(t));
+  }
+
+  // Act
+  a.erase(a.lower_bound(500));
+  auto tenth = a.select(10);
+  auto it = a.lower_bound(505);
+
+  // Assert
+  ASSERT_EQ(tenth->second, "100");
+  ASSERT_EQ(a.rank(505), 50);
+  ASSERT_EQ(it - a.begin(), 50);
+  ASSERT_EQ((it + 5)->first, 560);
+  ASSERT_EQ((it - 1)->first, 490);
+  ASSERT_TRUE(a.select(99) == a.end());
+}
+
+TEST(TestMap, Subtest_Heterogeneous_Lookup) {
+  // Arrange
+  s21::Map<std::string, int> a = {{"alpha", 1}, {"beta", 2}, {"gamma", 3}};
+  std::string_view beta = "beta";
+
+  // Act
+  auto it = a.find(beta);
+  auto missing = a.find(std::string_view("delta"));
+
+  // Assert
+  ASSERT_EQ(it->second, 2);
+  ASSERT_TRUE(missing == a.end());
+  ASSERT_TRUE(a.contains(std::string_view("gamma")));
+  ASSERT_FALSE(a.contains("delta"));
+  ASSERT_EQ(a.at(std::string_view("alpha")), 1);
+  ASSERT_THROW(a.at(std::string_view("delta")), std::out_of_range);
+  ASSERT_EQ(a.lower_bound(std::string_view("b"))->first, "beta");
+}
+
+TEST(TestMap, Subtest_Custom_Compare) {
+  // Arrange
+  s21::Map<int, std::string, std::greater<int>> a;
+  for (int t = 0; t < 5; ++t) a.insert(t, std::to_string(t));
+
+  // Act
+  auto it = a.begin();
+
+  // Assert
+  ASSERT_EQ(it->first, 4);
+  ASSERT_EQ((++it)->first, 3);
+  ASSERT_EQ(a.lower_bound(2)->first, 2);
+  ASSERT_EQ(a.upper_bound(2)->first, 1);
+  ASSERT_EQ(a.at(0), "0");
+}
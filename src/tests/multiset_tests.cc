@@ -335,4 +335,95 @@ TEST(Multiset, Multiset_Insert_Many_1) {
   // Assert
   ASSERT_EQ(my_set.size(), 8);
   ASSERT_EQ(my_set.count(4), 3);
-}
\ No newline at end of file
+}
+TEST(Multiset, FindMultiset_Duplicates) {
+  s21::Multiset<int> my_set = {5, 3, 8, 3, 1, 3, 9};
+  auto my_it = my_set.find(3);
+  ASSERT_EQ(*my_it, 3);
+  ASSERT_EQ(*(--my_it), 1);
+  ASSERT_TRUE(my_set.find(4) == my_set.end());
+}
+
+TEST(Multiset, EmplaceMultiset) {
+  s21::Multiset<std::string> my_set;
+  my_set.emplace(2, 'a');
+  my_set.emplace("aa");
+  my_set.insert(std::string("b"));
+  ASSERT_EQ(my_set.size(), 3);
+  ASSERT_EQ(my_set.count("aa"), 2);
+}
+
+TEST(Multiset, ExtractMultiset) {
+  s21::Multiset<int> my_set = {1, 2, 2, 3};
+  s21::Multiset<int> other = {2, 4};
+  auto node = my_set.extract(2);
+  auto it = other.insert(std::move(node));
+  ASSERT_EQ(*it, 2);
+  ASSERT_EQ(other.count(2), 2);
+  other.merge(my_set);
+  ASSERT_TRUE(my_set.empty());
+  ASSERT_EQ(other.size(), 6);
+  ASSERT_EQ(other.count(2), 3);
+}
+
+TEST(Multiset, SetAlgebraMultiset) {
+  s21::Multiset<int> a = {1, 1, 1, 2, 3, 3};
+  s21::Multiset<int> b = {1, 2, 2, 3, 4};
+  auto united = s21::set_union(a, b);
+  auto common = s21::set_intersection(a, b);
+  auto only_a = s21::set_difference(a, b);
+  auto either = s21::set_symmetric_difference(a, b);
+  ASSERT_EQ(united.size(), 8);
+  ASSERT_EQ(united.count(1), 3);
+  ASSERT_EQ(united.count(2), 2);
+  ASSERT_EQ(common.size(), 3);
+  ASSERT_EQ(only_a.size(), 3);
+  ASSERT_EQ(only_a.count(1), 2);
+  ASSERT_EQ(either.size(), 5);
+  ASSERT_EQ(either.count(4), 1);
+  united.insert(1);
+  ASSERT_EQ(united.count(1), 4);
+}
+
+TEST(Multiset, MergeMultisetLinear) {
+  s21::Multiset<int> my_set = {1, 3, 3, 5};
+  s21::Multiset<int> other = {0, 3, 6};
+  my_set.merge(other);
+  std::multiset<int> expected = {0, 1, 3, 3, 3, 5, 6};
+  ASSERT_TRUE(other.empty());
+  ASSERT_EQ(my_set.size(), expected.size());
+  auto it = my_set.begin();
+  for (int value : expected) ASSERT_EQ(*it++, value);
+}
+
+TEST(Multiset, BoundsMultiset_Duplicates) {
+  s21::Multiset<int> my_set;
+  for (int i = 0; i < 3000; ++i) my_set.insert(i % 3);
+  ASSERT_EQ(my_set.count(1), 1000);
+  ASSERT_EQ(my_set.count(3), 0);
+  auto lower = my_set.lower_bound(1);
+  auto upper = my_set.upper_bound(1);
+  ASSERT_EQ(*lower, 1);
+  ASSERT_EQ(*(--lower), 0);
+  ASSERT_EQ(*upper, 2);
+  ASSERT_EQ(*(--upper), 1);
+  auto range = my_set.equal_range(2);
+  ASSERT_EQ(*range.first, 2);
+  ASSERT_TRUE(++range.second == my_set.end());
+}
+
+TEST(Multiset, CustomCompareMultiset) {
+  s21::Multiset<std::string> words = {"pear", "apple", "pear", "fig"};
+  ASSERT_EQ(words.count(std::string_view("pear")), 2);
+  ASSERT_TRUE(words.contains(std::string_view("fig")));
+  auto range = words.equal_range(std::string_view("pear"));
+  ASSERT_EQ(*range.first, "pear");
+  ASSERT_EQ(*range.second, "pear");
+  ASSERT_TRUE(++range.second == words.end());
+
+  s21::Multiset<int, std::greater<int>> desc = {1, 3, 3, 2};
+  auto it = desc.begin();
+  for (int value : {3, 3, 2, 1}) ASSERT_EQ(*it++, value);
+  ASSERT_EQ(desc.count(3), 2);
+  ASSERT_EQ(*desc.upper_bound(3), 2);
+}
@@ -227,4 +227,177 @@ TEST(Set, InsertManySet) {
   for (; my_it != my_set.end(); ++my_it, ++reference_it) {
     ASSERT_TRUE(*reference_it == *my_it);
   }
-}
\ No newline at end of file
+}
+TEST(Set, EmplaceSet) {
+  s21::Set<std::string> my_set;
+  auto first = my_set.emplace(3, 'x');
+  auto second = my_set.emplace("xxx");
+  std::string moved = "abc";
+  auto third = my_set.insert(std::move(moved));
+  ASSERT_TRUE(first.second);
+  ASSERT_FALSE(second.second);
+  ASSERT_TRUE(third.second);
+  ASSERT_EQ(*first.first, "xxx");
+  ASSERT_EQ(*third.first, "abc");
+  ASSERT_EQ(my_set.size(), 2);
+}
+
+TEST(Set, EmplaceImmovableSet) {
+  struct Pinned {
+    explicit Pinned(int v) : value(v) {}
+    Pinned(const Pinned &) = delete;
+    Pinned(Pinned &&) = delete;
+    bool operator<(const Pinned &other) const { return value < other.value; }
+    int value;
+  };
+  s21::Set<Pinned> my_set;
+  ASSERT_TRUE(my_set.emplace(2).second);
+  ASSERT_TRUE(my_set.emplace(1).second);
+  ASSERT_FALSE(my_set.emplace(2).second);
+  ASSERT_EQ(my_set.size(), 2);
+  ASSERT_EQ(my_set.begin()->value, 1);
+}
+
+TEST(Set, ExtractSet) {
+  s21::Set<std::string> my_set = {"a", "b", "c"};
+  s21::Set<std::string> other;
+  auto node = my_set.extract("b");
+  ASSERT_EQ(node.key(), "b");
+  auto result = other.insert(std::move(node));
+  ASSERT_TRUE(result.inserted);
+  ASSERT_EQ(*result.position, "b");
+  ASSERT_EQ(my_set.size(), 2);
+  ASSERT_FALSE(my_set.contains("b"));
+  ASSERT_TRUE(other.contains("b"));
+}
+
+TEST(Set, SetAlgebra) {
+  s21::Set<int> a = {1, 2, 3, 5, 8};
+  s21::Set<int> b = {2, 4, 5, 6};
+  std::set<int> std_a = {1, 2, 3, 5, 8};
+  std::set<int> std_b = {2, 4, 5, 6};
+  std::vector<int> expected;
+  auto check = [&](s21::Set<int> result) {
+    ASSERT_EQ(result.size(), expected.size());
+    auto it = result.begin();
+    for (int value : expected) ASSERT_EQ(*it++, value);
+    expected.clear();
+  };
+
+  std::set_union(std_a.begin(), std_a.end(), std_b.begin(), std_b.end(),
+                 std::back_inserter(expected));
+  check(s21::set_union(a, b));
+  std::set_intersection(std_a.begin(), std_a.end(), std_b.begin(),
+                        std_b.end(), std::back_inserter(expected));
+  check(s21::set_intersection(a, b));
+  std::set_difference(std_a.begin(), std_a.end(), std_b.begin(), std_b.end(),
+                      std::back_inserter(expected));
+  check(s21::set_difference(a, b));
+  std::set_symmetric_difference(std_a.begin(), std_a.end(), std_b.begin(),
+                                std_b.end(), std::back_inserter(expected));
+  check(s21::set_symmetric_difference(a, b));
+}
+
+TEST(Set, SetAlgebraInPlace) {
+  s21::Set<int> a = {1, 2, 3};
+  s21::Set<int> b = {3, 4};
+  a.assign_set_operation(a, b, s21::Set<int>::SetOperation::kUnion);
+  ASSERT_EQ(a.size(), 4);
+  a.assign_set_operation(b, a, s21::Set<int>::SetOperation::kDifference);
+  ASSERT_TRUE(a.empty());
+  ASSERT_TRUE(s21::set_intersection(a, b).empty());
+}
+
+TEST(Set, BoundsSet) {
+  s21::Set<int> my_set = {1, 4, 9, 16, 25};
+  std::set<int> reference_set = {1, 4, 9, 16, 25};
+  for (int key = 0; key < 27; ++key) {
+    auto lower = my_set.lower_bound(key);
+    auto upper = my_set.upper_bound(key);
+    auto range = my_set.equal_range(key);
+    if (reference_set.lower_bound(key) == reference_set.end()) {
+      ASSERT_TRUE(lower == my_set.end());
+    } else {
+      ASSERT_EQ(*lower, *reference_set.lower_bound(key));
+    }
+    if (reference_set.upper_bound(key) == reference_set.end()) {
+      ASSERT_TRUE(upper == my_set.end());
+    } else {
+      ASSERT_EQ(*upper, *reference_set.upper_bound(key));
+    }
+    ASSERT_TRUE(range.first == lower);
+    ASSERT_TRUE(range.second == upper);
+    ASSERT_EQ(my_set.count(key), reference_set.count(key));
+  }
+}
+
+namespace {
+// Сравнение по модулю: состояние компаратора должно переживать копирование.
+struct ModuloLess {
+  int mod = 10;
+  bool operator()(int a, int b) const { return a % mod < b % mod; }
+};
+
+// Порядок задается состоянием, а не типом.
+struct Directed {
+  bool reverse = false;
+  bool operator()(int a, int b) const { return reverse ? b < a : a < b; }
+};
+}  // namespace
+
+TEST(Set, CustomCompareSet) {
+  s21::Set<int, ModuloLess> my_set(ModuloLess{7});
+  for (int i : {3, 10, 17, 5, 12, 13}) my_set.insert(i);
+  s21::Set<int, ModuloLess> copy = my_set;
+  ASSERT_EQ(my_set.size(), 3);
+  ASSERT_EQ(copy.key_comp().mod, 7);
+  ASSERT_TRUE(copy.contains(24));
+  ASSERT_FALSE(copy.contains(4));
+  auto it = copy.begin();
+  ASSERT_EQ(*it++, 3);
+  ASSERT_EQ(*it++, 5);
+  ASSERT_EQ(*it, 13);
+}
+
+TEST(Set, SetAlgebraKeepsComparator) {
+  s21::Set<int, Directed> a(Directed{true});
+  s21::Set<int, Directed> b(Directed{true});
+  for (int i : {1, 3, 5}) a.insert(i);
+  for (int i : {2, 3, 4}) b.insert(i);
+  auto check = [](s21::Set<int, Directed> result,
+                  std::vector<int> expected) {
+    ASSERT_TRUE(result.key_comp().reverse);
+    ASSERT_EQ(result.size(), expected.size());
+    auto it = result.begin();
+    for (int value : expected) ASSERT_EQ(*it++, value);
+  };
+  check(s21::set_union(a, b), {5, 4, 3, 2, 1});
+  check(s21::set_intersection(a, b), {3});
+  check(s21::set_difference(a, b), {5, 1});
+  check(s21::set_symmetric_difference(a, b), {5, 4, 2, 1});
+}
+
+namespace {
+// Ключ, считающий свои копирования.
+struct CountedKey {
+  static inline int copies = 0;
+  int value;
+  explicit CountedKey(int v = 0) : value(v) {}
+  CountedKey(const CountedKey &other) : value(other.value) { ++copies; }
+  CountedKey(CountedKey &&other) noexcept = default;
+  bool operator<(const CountedKey &other) const { return value < other.value; }
+};
+}  // namespace
+
+TEST(Set, InsertCopiesKeyOnce) {
+  s21::Set<CountedKey> my_set;
+  CountedKey key(1);
+  CountedKey::copies = 0;
+  my_set.insert(key);
+  ASSERT_EQ(CountedKey::copies, 1);
+  my_set.insert(CountedKey(2));
+  my_set.emplace(3);
+  ASSERT_EQ(CountedKey::copies, 1);
+  ASSERT_EQ(my_set.size(), 3);
+  ASSERT_EQ(my_set.begin()->value, 1);
+}
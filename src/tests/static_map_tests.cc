@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include "tests.h"
+
+TEST(StaticMap, BuildFromMap) {
+  s21::Map<int, std::string> map;
+  for (int i = 0; i < 500; ++i) map.insert(i * 2, std::to_string(i));
+  s21::StaticMap<int, std::string> frozen(map);
+  ASSERT_EQ(frozen.size(), 500);
+  ASSERT_EQ(frozen.at(10), "5");
+  ASSERT_THROW(frozen.at(11), std::out_of_range);
+  ASSERT_EQ(frozen.find(998)->second, "499");
+  ASSERT_TRUE(frozen.find(999) == frozen.end());
+  int expected = 0;
+  for (auto it = frozen.begin(); it != frozen.end(); ++it, expected += 2) {
+    ASSERT_EQ(it->first, expected);
+  }
+}
+
+TEST(StaticMap, BuildFromListAndVector) {
+  s21::StaticMap<std::string, int> frozen = {
+      {"b", 2}, {"a", 1}, {"c", 3}, {"a", 7}};
+  ASSERT_EQ(frozen.size(), 3);
+  ASSERT_EQ(frozen.at("a"), 1);
+  ASSERT_EQ(frozen.at(std::string_view("c")), 3);
+  ASSERT_EQ(frozen.lower_bound("bb")->first, "c");
+
+  s21::Vector<std::pair<int, int>> sorted = {{1, 10}, {2, 20}, {5, 50}};
+  s21::StaticMap<int, int> from_vector(sorted);
+  ASSERT_EQ(from_vector.at(5), 50);
+  ASSERT_EQ(from_vector.upper_bound(2)->second, 50);
+}
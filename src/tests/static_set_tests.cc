@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "tests.h"
+
+TEST(StaticSet, BuildFromSet) {
+  for (int count : {0, 1, 2, 7, 8, 100, 1000}) {
+    s21::Set<int> set;
+    for (int i = 0; i < count; ++i) set.insert(i * 3);
+    s21::StaticSet<int> frozen(set);
+    ASSERT_EQ(frozen.size(), set.size());
+    int expected = 0;
+    for (auto it = frozen.begin(); it != frozen.end(); ++it, expected += 3) {
+      ASSERT_EQ(*it, expected);
+    }
+    ASSERT_EQ(expected, count * 3);
+    for (int key = -1; key <= count * 3; ++key) {
+      ASSERT_EQ(frozen.contains(key), key >= 0 && key % 3 == 0 &&
+                                          key < count * 3);
+    }
+  }
+}
+
+TEST(StaticSet, Bounds) {
+  s21::StaticSet<int> frozen = {40, 10, 30, 20, 10};
+  ASSERT_EQ(frozen.size(), 4);
+  ASSERT_EQ(*frozen.lower_bound(20), 20);
+  ASSERT_EQ(*frozen.lower_bound(21), 30);
+  ASSERT_EQ(*frozen.upper_bound(20), 30);
+  ASSERT_EQ(*frozen.lower_bound(-5), 10);
+  ASSERT_TRUE(frozen.lower_bound(41) == frozen.end());
+  ASSERT_TRUE(frozen.upper_bound(40) == frozen.end());
+  ASSERT_TRUE(frozen.find(25) == frozen.end());
+  ASSERT_EQ(frozen.count(30), 1);
+  auto it = frozen.end();
+  ASSERT_EQ(*--it, 40);
+  ASSERT_EQ(*--it, 30);
+}
+
+TEST(StaticSet, BuildFromVector) {
+  s21::Vector<int> sorted = {1, 4, 9, 16, 25};
+  s21::StaticSet<int> frozen(sorted);
+  ASSERT_TRUE(frozen.contains(16));
+  ASSERT_FALSE(frozen.contains(15));
+  s21::Vector<int> unsorted = {1, 9, 4};
+  ASSERT_THROW(s21::StaticSet<int> bad(unsorted), std::invalid_argument);
+}
+
+TEST(StaticSet, StringsCopyMove) {
+  s21::Set<std::string> set = {"pear", "apple", "fig", "plum"};
+  s21::StaticSet<std::string> frozen(set);
+  s21::StaticSet<std::string> copy = frozen;
+  s21::StaticSet<std::string> moved = std::move(frozen);
+  ASSERT_TRUE(frozen.empty());
+  ASSERT_TRUE(copy.contains(std::string_view("fig")));
+  ASSERT_EQ(*moved.begin(), "apple");
+  ASSERT_EQ(moved.size(), 4);
+}
@@ -2,14 +2,19 @@
 #define TESTS_H
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
+#include <iterator>
 #include <list>
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
+#include <sstream>
 #include <stack>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
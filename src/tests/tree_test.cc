@@ -69,4 +69,593 @@ TEST(Test_Tree, Subtest_Constructor_5) {
   ASSERT_FALSE(b.empty());
   ASSERT_EQ((*it++), 2);
   ASSERT_EQ((*it), 3);
-}
\ No newline at end of file
+}
+
+TEST(Test_Tree, Subtest_Lookup_1) {
+  // Arrange
+  s21::Tree<int, int> a{{50, 0}, {20, 1}, {80, 2}, {10, 3}, {30, 4}, {70, 5}};
+
+  // Act
+
+  // Assert
+  ASSERT_EQ(a.at(50), 0);
+  ASSERT_EQ(a.at(10), 3);
+  ASSERT_EQ(a.at(30), 4);
+  ASSERT_EQ(a.at(70), 5);
+  ASSERT_THROW(a.at(25), std::out_of_range);
+  ASSERT_THROW(a.at(90), std::out_of_range);
+}
+
+TEST(Test_Tree, Subtest_Lookup_2) {
+  // Arrange
+  s21::Map<int, int> a;
+  for (int i = 0; i < 1000; ++i) {
+    int key = (i * 7919) % 1000;
+    a.insert(key, -key);
+  }
+
+  // Act
+
+  // Assert
+  ASSERT_EQ(a.size(), 1000);
+  for (int key = 0; key < 1000; ++key) {
+    ASSERT_TRUE(a.contains(key));
+    ASSERT_EQ(a.at(key), -key);
+  }
+  ASSERT_FALSE(a.contains(-1));
+  ASSERT_FALSE(a.contains(1000));
+}
+
+TEST(Test_Tree, Subtest_Balance_Sorted_Insert) {
+  // Arrange
+  const int count = 200000;
+  s21::Set<int> a;
+
+  // Act
+  for (int i = 0; i < count; ++i) {
+    a.insert(i);
+  }
+
+  // Assert
+  ASSERT_EQ(a.size(), count);
+  int expected = 0;
+  for (auto it = a.begin(); it != a.end(); ++it) {
+    ASSERT_EQ(*it, expected++);
+  }
+  ASSERT_EQ(expected, count);
+}
+
+TEST(Test_Tree, Subtest_Balance_Erase) {
+  // Arrange
+  const int count = 10000;
+  s21::Map<int, int> a;
+  for (int i = count; i > 0; --i) {
+    a.insert(i, i * 2);
+  }
+
+  // Act
+  auto it = a.begin();
+  while (it != a.end()) {
+    auto next = it;
+    ++next;
+    a.erase(it);
+    if (next != a.end()) ++next;
+    it = next;
+  }
+
+  // Assert
+  ASSERT_EQ(a.size(), count / 2);
+  int expected = 2;
+  for (it = a.begin(); it != a.end(); ++it, expected += 2) {
+    ASSERT_EQ(it->first, expected);
+    ASSERT_EQ(it->second, expected * 2);
+  }
+  ASSERT_FALSE(a.contains(1));
+  ASSERT_TRUE(a.contains(count));
+}
+
+TEST(Test_Tree, Subtest_Balance_Multiset_Random) {
+  // Arrange
+  s21::Multiset<int> a;
+  std::multiset<int> b;
+  unsigned seed = 21;
+
+  // Act
+  for (int i = 0; i < 5000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int value = static_cast<int>(seed >> 16) % 300;
+    if (seed % 3 == 0 && b.count(value) != 0) {
+      a.erase(a.find(value));
+      b.erase(b.find(value));
+    } else {
+      a.insert(value);
+      b.insert(value);
+    }
+  }
+
+  // Assert
+  ASSERT_EQ(a.size(), b.size());
+  auto b_it = b.begin();
+  for (auto it = a.begin(); it != a.end(); ++it, ++b_it) {
+    ASSERT_EQ(*it, *b_it);
+  }
+}
+
+TEST(Test_Tree, Subtest_Iterator_End_1) {
+  // Arrange
+  s21::Tree<int, int> a;
+
+  // Act
+
+  // Assert
+  ASSERT_TRUE(a.begin() == a.end());
+  ASSERT_TRUE(--a.end() == a.end());
+}
+
+TEST(Test_Tree, Subtest_Iterator_End_2) {
+  // Arrange
+  s21::Set<int> a{5, 1, 9, 3, 7};
+  std::set<int> b{5, 1, 9, 3, 7};
+
+  // Act
+  auto it = a.end();
+  auto b_it = b.end();
+
+  // Assert
+  while (it != a.begin()) {
+    ASSERT_EQ(*--it, *--b_it);
+  }
+  ASSERT_TRUE(b_it == b.begin());
+  ASSERT_TRUE(++(--a.end()) == a.end());
+}
+
+TEST(Test_Tree, Subtest_Iterator_Swap) {
+  // Arrange
+  s21::Set<int> a{1, 2, 3};
+  s21::Set<int> b;
+
+  // Act
+  a.swap(b);
+
+  // Assert
+  ASSERT_TRUE(a.begin() == a.end());
+  ASSERT_EQ(*b.begin(), 1);
+  ASSERT_EQ(*--b.end(), 3);
+  int expected = 1;
+  for (auto it = b.begin(); it != b.end(); ++it) {
+    ASSERT_EQ(*it, expected++);
+  }
+  ASSERT_EQ(expected, 4);
+}
+
+TEST(Test_Tree, Subtest_Allocator_Std) {
+  // Arrange
+  s21::Map<int, std::string, std::less<>,
+           std::allocator<std::pair<const int, std::string>>>
+      a;
+
+  // Act
+  for (int i = 0; i < 100; ++i) {
+    a.insert(i, std::to_string(i));
+  }
+  a.erase(a.begin());
+
+  // Assert
+  ASSERT_EQ(a.size(), 99);
+  ASSERT_EQ(a.at(42), "42");
+}
+
+TEST(Test_Tree, Subtest_Allocator_Clear_Reuse) {
+  // Arrange
+  s21::Map<int, std::string> a;
+  for (int i = 0; i < 1000; ++i) {
+    a.insert(i, std::string(40, 'x'));
+  }
+
+  // Act
+  a.clear();
+  for (int i = 0; i < 10; ++i) {
+    a.insert(i, std::to_string(i));
+  }
+
+  // Assert
+  ASSERT_EQ(a.size(), 10);
+  ASSERT_EQ(a.at(7), "7");
+}
+
+TEST(Test_Tree, Subtest_Allocator_Shared) {
+  // Arrange
+  s21::SlabAllocator<std::pair<const int, int>> pool;
+  s21::Map<int, int> a(pool);
+  s21::Map<int, int> b(pool);
+
+  // Act
+  for (int i = 0; i < 500; ++i) {
+    a.insert(i, i);
+    b.insert(-i, i);
+  }
+  a.clear();
+
+  // Assert
+  ASSERT_TRUE(a.get_allocator() == b.get_allocator());
+  ASSERT_TRUE(a.get_allocator() == pool);
+  ASSERT_TRUE(a.empty());
+  ASSERT_EQ(b.size(), 500);
+  ASSERT_EQ(b.at(-499), 499);
+}
+
+TEST(Test_Tree, Subtest_Allocator_Copy) {
+  // Arrange
+  s21::Set<int> a{3, 1, 2};
+
+  // Act
+  s21::Set<int> b(a);
+
+  // Assert
+  ASSERT_FALSE(a.get_allocator() == b.get_allocator());
+  ASSERT_EQ(b.size(), 3);
+  ASSERT_EQ(*b.begin(), 1);
+}
+
+TEST(Test_Tree, Subtest_Allocator_Move) {
+  // Arrange
+  s21::Map<int, int> a{{1, 1}, {2, 2}};
+
+  // Act
+  s21::Map<int, int> b(std::move(a));
+  a.insert(3, 3);
+
+  // Assert
+  ASSERT_FALSE(a.get_allocator() == b.get_allocator());
+  ASSERT_EQ(a.size(), 1);
+  ASSERT_EQ(b.size(), 2);
+}
+
+TEST(Test_Tree, Subtest_Allocator_Lazy) {
+  // Arrange
+  s21::SlabAllocator<int> a;
+  s21::SlabAllocator<int> b;
+
+  // Act
+  s21::SlabAllocator<int> c(a);
+
+  // Assert
+  ASSERT_FALSE(a == b);
+  ASSERT_TRUE(a == c);
+  ASSERT_TRUE(b == b);
+}
+
+TEST(Test_Tree, Subtest_Allocator_Merge) {
+  // Arrange
+  s21::Map<int, std::string> a;
+  s21::Map<int, std::string> b;
+  for (int i = 0; i < 100; ++i) {
+    a.insert(2 * i, std::string(40, 'a'));
+    b.insert(3 * i, std::string(40, 'b'));
+  }
+
+  // Act
+  a.merge(b);
+  a.clear();
+  for (int i = 0; i < 100; ++i) b.insert(-i, "x");
+
+  // Assert
+  ASSERT_FALSE(a.get_allocator() == b.get_allocator());
+  ASSERT_EQ(b.size(), 34 + 99);
+  ASSERT_EQ(b.at(6), std::string(40, 'b'));
+  ASSERT_FALSE(b.contains(3));
+}
+
+TEST(Test_Tree, Subtest_Assign_Sorted_1) {
+  // Arrange
+  std::vector<std::pair<const int, int>> items;
+  for (int i = 0; i < 1000; ++i) {
+    items.emplace_back(i, i * i);
+  }
+
+  // Act
+  s21::Map<int, int> a(items.begin(), items.end());
+
+  // Assert
+  ASSERT_EQ(a.size(), 1000);
+  ASSERT_EQ(a.at(999), 999 * 999);
+  ASSERT_EQ(*a.begin(), 0);
+  ASSERT_EQ(*--a.end(), 999);
+  a.erase(a.begin());
+  a.insert(-1, 1);
+  int expected = -1;
+  for (auto it = a.begin(); it != a.end(); ++it) {
+    ASSERT_EQ(it->first, expected);
+    expected = expected == -1 ? 1 : expected + 1;
+  }
+}
+
+TEST(Test_Tree, Subtest_Assign_Sorted_2) {
+  // Arrange
+  std::vector<int> keys{1, 2, 2, 3, 7, 5, 4, 7};
+  s21::Set<int> a{100, 200};
+  s21::Multiset<int> b(keys.begin(), keys.end());
+
+  // Act
+  a.assign_sorted(keys.begin(), keys.end());
+
+  // Assert
+  std::set<int> expected_set(keys.begin(), keys.end());
+  std::multiset<int> expected_multiset(keys.begin(), keys.end());
+  ASSERT_EQ(a.size(), expected_set.size());
+  ASSERT_EQ(b.size(), expected_multiset.size());
+  auto set_it = expected_set.begin();
+  for (auto it = a.begin(); it != a.end(); ++it, ++set_it) {
+    ASSERT_EQ(*it, *set_it);
+  }
+  auto multiset_it = expected_multiset.begin();
+  for (auto it = b.begin(); it != b.end(); ++it, ++multiset_it) {
+    ASSERT_EQ(*it, *multiset_it);
+  }
+}
+
+TEST(Test_Tree, Subtest_Assign_Sorted_3) {
+  // Arrange
+  std::istringstream input("1 3 5 7 9 11");
+  std::istream_iterator<int> first(input);
+  std::istream_iterator<int> last;
+
+  // Act
+  s21::Set<int> a(first, last);
+  for (int i = 0; i < 6; ++i) {
+    a.erase(a.begin());
+  }
+
+  // Assert
+  ASSERT_TRUE(a.empty());
+}
+
+TEST(Test_Tree, Subtest_Clone_1) {
+  // Arrange
+  s21::Map<int, int> a;
+  for (int i = 0; i < 1000; ++i) {
+    a.insert((i * 7) % 1000, i);
+  }
+
+  // Act
+  s21::Map<int, int> b(a);
+  a.erase(a.begin());
+
+  // Assert
+  ASSERT_EQ(b.size(), 1000);
+  int expected = 0;
+  for (auto it = b.begin(); it != b.end(); ++it, ++expected) {
+    ASSERT_EQ(it->first, expected);
+    ASSERT_EQ(it->second, expected * 143 % 1000);
+  }
+  ASSERT_EQ(a.size(), 999);
+}
+
+TEST(Test_Tree, Subtest_Clone_2) {
+  // Arrange
+  s21::Set<std::string> a = {"b", "d", "f"};
+  s21::Set<std::string> b = {"a", "c", "e", "g", "h"};
+
+  // Act
+  b = a;
+  b.insert("z");
+
+  // Assert
+  ASSERT_EQ(b.size(), 4);
+  auto it = b.begin();
+  ASSERT_EQ(*it++, "b");
+  ASSERT_EQ(*it++, "d");
+  ASSERT_EQ(*it++, "f");
+  ASSERT_EQ(*it++, "z");
+  ASSERT_TRUE(it == b.end());
+  ASSERT_EQ(*--it, "z");
+  ASSERT_EQ(a.size(), 3);
+}
+
+TEST(Test_Tree, Subtest_Clone_3) {
+  // Arrange
+  s21::Multiset<int> a = {1, 1, 2, 3, 3, 3};
+  s21::Multiset<int> b = {5};
+  s21::Multiset<int> empty;
+
+  // Act
+  b = a;
+  s21::Multiset<int> c(b);
+  b = empty;
+
+  // Assert
+  ASSERT_TRUE(b.empty());
+  ASSERT_TRUE(b.begin() == b.end());
+  ASSERT_EQ(c.size(), 6);
+  ASSERT_EQ(c.count(3), 3);
+  ASSERT_EQ(*c.begin(), 1);
+  c.insert(0);
+  ASSERT_EQ(*c.begin(), 0);
+}
+
+TEST(Test_Tree, Subtest_Split_Join_1) {
+  // Arrange
+  s21::Set<int> a;
+  s21::Set<int> right = {-1};
+  s21::Set<int> middle;
+  for (int i = 0; i < 1000; ++i) {
+    a.insert(i * 2);
+  }
+
+  // Act
+  auto pivot = a.split(500, right);
+  auto missing = a.split(301, middle);
+
+  // Assert
+  ASSERT_EQ(pivot.key(), 500);
+  ASSERT_TRUE(missing.empty());
+  ASSERT_EQ(a.size(), 151);
+  ASSERT_EQ(middle.size(), 99);
+  ASSERT_EQ(right.size(), 749);
+  ASSERT_EQ(*middle.begin(), 302);
+  ASSERT_EQ(*--a.end(), 300);
+  ASSERT_EQ(*right.begin(), 502);
+
+  // Act
+  s21::Set<int> joined;
+  joined.join(middle, std::move(pivot), right);
+
+  // Assert
+  ASSERT_TRUE(middle.empty());
+  ASSERT_TRUE(right.empty());
+  ASSERT_EQ(joined.size(), 849);
+  ASSERT_EQ(*joined.begin(), 302);
+  ASSERT_TRUE(joined.contains(500));
+  ASSERT_FALSE(joined.contains(300));
+  ASSERT_EQ(*--joined.end(), 1998);
+}
+
+TEST(Test_Tree, Subtest_Split_Join_2) {
+  // Arrange
+  s21::Multiset<int> a = {1, 2, 2, 2, 3};
+  s21::Multiset<int> right;
+
+  // Act
+  auto pivot = a.split(2, right);
+  s21::Multiset<int> joined;
+  joined.join(a, s21::Multiset<int>::node_type(), right);
+
+  // Assert
+  ASSERT_EQ(pivot.key(), 2);
+  ASSERT_TRUE(a.empty());
+  ASSERT_EQ(joined.size(), 4);
+  ASSERT_EQ(*joined.begin(), 1);
+  ASSERT_EQ(*++joined.begin(), 2);
+  ASSERT_EQ(joined.count(2), 2);
+}
+
+TEST(Test_Tree, Subtest_Split_Join_Allocator) {
+  // Arrange
+  s21::Set<int> a;
+  s21::Set<int> b;
+  s21::Set<int> right;
+  for (int i = 0; i < 1000; ++i) {
+    a.insert(i);
+    b.insert(i * 3);
+  }
+
+  // Act
+  a.split(600, right);
+  a.union_with(b);
+  a.clear();
+  right.insert(-1);
+  b.insert(-1);
+
+  // Assert
+  ASSERT_FALSE(a.get_allocator() == right.get_allocator());
+  ASSERT_FALSE(a.get_allocator() == b.get_allocator());
+  ASSERT_EQ(right.size(), 400);
+  ASSERT_EQ(*++right.begin(), 601);
+  ASSERT_EQ(b.size(), 1);
+}
+
+TEST(Test_Tree, Subtest_Join_Set_Operations) {
+  // Arrange
+  const int count = 60000;
+  s21::Set<int> a[4];
+  s21::Set<int> b[4];
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < count; ++j) {
+      a[i].insert(j * 2);
+      b[i].insert(j * 3);
+    }
+  }
+
+  // Act
+  a[0].union_with(b[0], 4);
+  a[1].intersect_with(b[1], 4);
+  a[2].difference_with(b[2], 1);
+  a[3].symmetric_difference_with(b[3]);
+
+  // Assert
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(b[i].empty());
+  }
+  ASSERT_EQ(a[0].size(), 100000);
+  ASSERT_EQ(a[1].size(), 20000);
+  ASSERT_EQ(a[2].size(), 40000);
+  ASSERT_EQ(a[3].size(), 80000);
+  int expected = 0;
+  for (auto it = a[1].begin(); it != a[1].end(); ++it, expected += 6) {
+    ASSERT_EQ(*it, expected);
+  }
+  ASSERT_TRUE(a[0].contains(3));
+  ASSERT_FALSE(a[2].contains(6));
+  ASSERT_TRUE(a[3].contains(179997));
+}
+
+TEST(Test_Tree, Subtest_Order_Statistics_1) {
+  // Arrange
+  s21::Multiset<int, std::less<>, s21::SlabAllocator<int>,
+                s21::OrderStatistics>
+      latency;
+  for (int i = 1000; i > 0; --i) {
+    latency.insert(i % 100);
+  }
+  for (int i = 0; i < 100; i += 2) {
+    latency.erase(latency.find(i));
+  }
+
+  // Act
+  size_t total = latency.size();
+  int p50 = *latency.select(total / 2);
+  int p99 = *latency.nth(total * 99 / 100);
+
+  // Assert
+  ASSERT_EQ(total, 950);
+  ASSERT_EQ(p50, 50);
+  ASSERT_EQ(p99, 99);
+  ASSERT_EQ(latency.rank(0), 0);
+  ASSERT_EQ(latency.rank(1), 9);
+  ASSERT_EQ(latency.rank(2), 19);
+  ASSERT_EQ(latency.rank(100), 950);
+  ASSERT_EQ(latency.count(1), 10);
+  ASSERT_EQ(latency.count(2), 9);
+  ASSERT_TRUE(latency.select(950) == latency.end());
+}
+
+TEST(Test_Tree, Subtest_Order_Statistics_2) {
+  // Arrange
+  using RankedSet =
+      s21::Set<int, std::less<>, s21::SlabAllocator<int>, s21::OrderStatistics>;
+  RankedSet a;
+  RankedSet b;
+  for (int i = 0; i < 3000; ++i) {
+    a.insert(i * 2);
+    b.insert(i * 3);
+  }
+
+  // Act
+  a.union_with(b);
+  auto first = a.begin();
+  auto middle = first + 2000;
+  auto last = a.end();
+  auto copy = a;
+  RankedSet right;
+  auto pivot = copy.split(*middle, right);
+
+  // Assert
+  ASSERT_EQ(a.size(), 5000);
+  ASSERT_EQ(*middle, 3000);
+  ASSERT_EQ(middle - first, 2000);
+  ASSERT_EQ(last - middle, 3000);
+  ASSERT_EQ(*(middle - 1), 2998);
+  ASSERT_TRUE(middle + 3000 == last);
+  ASSERT_EQ(*(last - 1), 8997);
+  middle += 1;
+  ASSERT_EQ(*middle, 3002);
+  middle -= 2;
+  ASSERT_EQ(*middle, 2998);
+  ASSERT_EQ(a.rank(3000), 2000);
+  ASSERT_EQ(a.rank(2999), 2000);
+  ASSERT_EQ(copy.size(), 2000);
+  ASSERT_EQ(right.size(), 2999);
+  ASSERT_EQ(*copy.select(1999), 2998);
+  ASSERT_EQ(*right.select(0), 3002);
+  ASSERT_EQ(pivot.key(), 3000);
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+
+#include "tests.h"
+
+namespace {
+
+struct StringHash {
+  using is_transparent = void;
+  size_t operator()(std::string_view str) const {
+    return std::hash<std::string_view>()(str);
+  }
+};
+
+// Считает копии ключа: перестройка и слияние должны ключи перемещать.
+struct CountedKey {
+  explicit CountedKey(int v) : value(v) {}
+  CountedKey(const CountedKey &other) : value(other.value) { ++copies; }
+  CountedKey(CountedKey &&other) noexcept : value(other.value) {}
+  CountedKey &operator=(const CountedKey &other) = default;
+  CountedKey &operator=(CountedKey &&other) noexcept = default;
+  bool operator==(const CountedKey &other) const {
+    return value == other.value;
+  }
+
+  static int copies;
+  int value;
+};
+
+int CountedKey::copies = 0;
+
+struct CountedKeyHash {
+  size_t operator()(const CountedKey &key) const {
+    return std::hash<int>()(key.value);
+  }
+};
+
+// Копия ключа бросает исключение, когда счетчик доходит до нуля; перенос
+// не noexcept, поэтому перестройка копирует ключи.
+struct FragileKey {
+  explicit FragileKey(int v) : value(v) {}
+  FragileKey(const FragileKey &other) : value(other.value) {
+    if (budget >= 0 && budget-- == 0) throw std::runtime_error("copy");
+  }
+  bool operator==(const FragileKey &other) const {
+    return value == other.value;
+  }
+
+  static int budget;
+  int value;
+};
+
+int FragileKey::budget = -1;
+
+struct FragileKeyHash {
+  size_t operator()(const FragileKey &key) const {
+    return std::hash<int>()(key.value);
+  }
+};
+
+}  // namespace
+
+TEST(UnorderedMap, Interface) {
+  s21::UnorderedMap<int, double> map = {{3, 0.3}, {1, 0.1}, {2, 0.2}, {1, 9.9}};
+  ASSERT_EQ(map.size(), 3);
+  ASSERT_EQ(map.at(1), 0.1);
+  ASSERT_THROW(map.at(4), std::out_of_range);
+  map[4] = 0.4;
+  ASSERT_FALSE(map.insert(4, 1.0).second);
+  ASSERT_FALSE(map.insert_or_assign(4, 1.0).second);
+  ASSERT_EQ(map[4], 1.0);
+  ASSERT_TRUE(map.try_emplace(0, 0.0).second);
+  ASSERT_TRUE(map.emplace(7, 0.7).second);
+  ASSERT_EQ(map.find(7)->second, 0.7);
+  ASSERT_TRUE(map.find(5) == map.end());
+  ASSERT_EQ(map.erase(2), 1);
+  ASSERT_EQ(map.erase(2), 0);
+  map.erase(map.find(3));
+  ASSERT_FALSE(map.contains(3));
+  ASSERT_EQ(map.count(7), 1);
+
+  std::map<int, double> seen;
+  for (auto it = map.begin(); it != map.end(); ++it) {
+    seen.insert({*it, it->second});
+  }
+  std::map<int, double> expected = {{0, 0.0}, {1, 0.1}, {4, 1.0}, {7, 0.7}};
+  ASSERT_EQ(seen, expected);
+  map.clear();
+  ASSERT_TRUE(map.empty());
+  ASSERT_TRUE(map.begin() == map.end());
+}
+
+TEST(UnorderedMap, HeterogeneousLookup) {
+  s21::UnorderedMap<std::string, int, StringHash> map;
+  map["alpha"] = 1;
+  map["beta"] = 2;
+  std::string_view key = "beta";
+  ASSERT_TRUE(map.contains(key));
+  ASSERT_EQ(map.find(key)->second, 2);
+  ASSERT_EQ(map.at(std::string_view("alpha")), 1);
+  ASSERT_FALSE(map.contains(std::string_view("gamma")));
+  ASSERT_THROW(map.at(std::string_view("gamma")), std::out_of_range);
+}
+
+TEST(UnorderedMap, Capacity) {
+  s21::UnorderedMap<int, int> map;
+  ASSERT_EQ(map.bucket_count(), 0);
+  ASSERT_EQ(map.load_factor(), 0.0f);
+  map.reserve(1000);
+  size_t buckets = map.bucket_count();
+  ASSERT_GE(buckets * map.max_load_factor(), 1000);
+  for (int i = 0; i < 1000; ++i) map.insert(i, i);
+  ASSERT_EQ(map.bucket_count(), buckets);
+  ASSERT_LE(map.load_factor(), map.max_load_factor());
+
+  map.max_load_factor(0.5f);
+  ASSERT_EQ(map.max_load_factor(), 0.5f);
+  ASSERT_LE(map.load_factor(), 0.5f);
+  map.max_load_factor(2.0f);
+  ASSERT_LT(map.max_load_factor(), 1.0f);
+  map.rehash(8192);
+  ASSERT_GE(map.bucket_count(), 8192);
+  for (int i = 0; i < 1000; ++i) ASSERT_EQ(map.at(i), i);
+
+  map.clear();
+  map.rehash(0);
+  ASSERT_EQ(map.bucket_count(), 0);
+  map[1] = 2;
+  ASSERT_EQ(map.at(1), 2);
+}
+
+TEST(UnorderedMap, AgainstStdUnorderedMap) {
+  std::unordered_map<int, int> std;
+  s21::UnorderedMap<int, int> map;
+  unsigned seed = 11;
+  for (int i = 0; i < 20000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>(seed >> 16) % 3000;
+    if (seed % 3 == 0) {
+      ASSERT_EQ(map.erase(key), std.erase(key));
+    } else {
+      ASSERT_EQ(map.insert(key, i).second, std.insert({key, i}).second);
+    }
+    ASSERT_EQ(map.size(), std.size());
+  }
+  size_t visited = 0;
+  for (auto it = map.begin(); it != map.end(); ++it, ++visited) {
+    ASSERT_EQ(std.at(*it), it->second);
+  }
+  ASSERT_EQ(visited, std.size());
+  for (int key = 0; key < 3000; ++key) {
+    ASSERT_EQ(map.contains(key), std.count(key) == 1);
+  }
+}
+
+TEST(UnorderedMap, CopyMoveMerge) {
+  s21::UnorderedMap<std::string, std::string> map;
+  for (int i = 0; i < 100; ++i) map[std::to_string(i)] = std::to_string(-i);
+  s21::UnorderedMap<std::string, std::string> copy(map);
+  ASSERT_EQ(copy.size(), 100);
+  ASSERT_EQ(copy.at("42"), "-42");
+  s21::UnorderedMap<std::string, std::string> moved(std::move(copy));
+  ASSERT_EQ(moved.size(), 100);
+  ASSERT_TRUE(copy.empty());
+  copy = moved;
+  ASSERT_EQ(copy.at("99"), "-99");
+
+  s21::UnorderedMap<std::string, std::string> other = {{"7", "x"},
+                                                       {"100", "y"}};
+  map.merge(other);
+  ASSERT_EQ(map.size(), 101);
+  ASSERT_EQ(map.at("100"), "y");
+  ASSERT_EQ(other.size(), 1);
+  ASSERT_EQ(other.begin()->second, "x");
+
+  auto results = map.insert_many(std::pair<const std::string, std::string>{
+                                     "101", "a"},
+                                 std::pair<const std::string, std::string>{
+                                     "0", "b"});
+  ASSERT_TRUE(results[0].second);
+  ASSERT_FALSE(results[1].second);
+  ASSERT_EQ(results[0].first->second, "a");
+  ASSERT_EQ(results[1].first->second, "0");
+}
+
+TEST(UnorderedMap, RehashAndMergeMoveKeys) {
+  s21::UnorderedMap<CountedKey, int, CountedKeyHash> map;
+  s21::UnorderedMap<CountedKey, int, CountedKeyHash> other;
+  CountedKey::copies = 0;
+  for (int i = 0; i < 10000; ++i) {
+    map.try_emplace(CountedKey(i), i);
+    other.try_emplace(CountedKey(-i), i);
+  }
+  map.merge(other);
+  ASSERT_EQ(CountedKey::copies, 0);
+  ASSERT_EQ(map.size(), 19999);
+  ASSERT_EQ(other.size(), 1);
+  ASSERT_EQ(map.at(CountedKey(-42)), 42);
+}
+
+TEST(UnorderedMap, ThrowingRehashKeepsTable) {
+  s21::UnorderedMap<FragileKey, int, FragileKeyHash> map;
+  map.insert(FragileKey(0), 0);
+  const size_t buckets = map.bucket_count();
+  int count = 1;
+  for (; map.size() < buckets * map.max_load_factor(); ++count) {
+    map.insert(FragileKey(count), count);
+  }
+  ASSERT_EQ(map.bucket_count(), buckets);
+  FragileKey::budget = 3;
+  ASSERT_THROW(map.insert(FragileKey(count), count), std::runtime_error);
+  FragileKey::budget = -1;
+  ASSERT_EQ(map.bucket_count(), buckets);
+  ASSERT_EQ(map.size(), static_cast<size_t>(count));
+  for (int i = 0; i < count; ++i) ASSERT_EQ(map.at(FragileKey(i)), i);
+}
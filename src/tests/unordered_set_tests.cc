@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include "tests.h"
+
+TEST(UnorderedSet, Interface) {
+  s21::UnorderedSet<int> set = {5, 1, 4, 1, 3};
+  ASSERT_EQ(set.size(), 4);
+  ASSERT_FALSE(set.insert(4).second);
+  ASSERT_TRUE(set.emplace(2).second);
+  ASSERT_EQ(*set.insert(0).first, 0);
+  ASSERT_EQ(set.count(2), 1);
+  set.erase(set.find(3));
+  ASSERT_FALSE(set.contains(3));
+  std::set<int> seen;
+  for (auto it = set.begin(); it != set.end(); ++it) seen.insert(*it);
+  std::set<int> expected = {0, 1, 2, 4, 5};
+  ASSERT_EQ(seen, expected);
+
+  auto results = set.insert_many(9, 1, 9);
+  ASSERT_TRUE(results[0].second);
+  ASSERT_FALSE(results[1].second);
+  ASSERT_FALSE(results[2].second);
+  ASSERT_TRUE(results[0].first == results[2].first);
+  ASSERT_EQ(set.size(), 6);
+}
+
+TEST(UnorderedSet, EraseAndReinsert) {
+  s21::UnorderedSet<std::string> set;
+  for (int round = 0; round < 5; ++round) {
+    for (int i = 0; i < 500; ++i) set.insert(std::to_string(i));
+    ASSERT_EQ(set.size(), 500);
+    for (int i = 0; i < 500; i += 2) ASSERT_EQ(set.erase(std::to_string(i)), 1);
+    ASSERT_EQ(set.size(), 250);
+    for (int i = 0; i < 500; ++i) {
+      ASSERT_EQ(set.contains(std::to_string(i)), i % 2 == 1);
+    }
+    set.clear();
+  }
+  ASSERT_LE(set.bucket_count(), 1024);
+}
@@ -308,6 +308,8 @@ TEST(Vector, Insert_Middle) {
   ASSERT_EQ(v.size(), 4);
   ASSERT_EQ(v[1], 2);
   ASSERT_EQ(*it, 2);
+  ASSERT_EQ(v[2], 3);
+  ASSERT_EQ(v[3], 4);
 }
 
 TEST(Vector, Insert_End) {
@@ -339,6 +341,14 @@ TEST(Vector, Erase_End) {
   ASSERT_EQ(v[2], 3);
 }
 
+TEST(Vector, Erase_PastTheEnd) {
+  s21::Vector<int> v = {1, 2, 3, 4};
+  ASSERT_THROW(v.erase(v.end()), std::out_of_range);
+  ASSERT_EQ(v.size(), 4);
+  s21::Vector<int> empty;
+  ASSERT_THROW(empty.erase(empty.begin()), std::out_of_range);
+}
+
 TEST(Vector, PushBack_EmptyVector) {
   s21::Vector<int> v;
   v.push_back(1);
@@ -394,39 +404,400 @@ TEST(Vector, Swap_EmptyAndNonEmptyVectors) {
   ASSERT_TRUE(v2.empty());
 }
 
-// TEST(Vector, InsertMany) {
-//    s21::Vector<int> vec = {1, 2, 3, 7, 8};
-//    s21::Vector<int>::const_iterator pos = vec.begin() + 3;
+namespace {
+
+// Считает живые объекты и способы, которыми они создавались.
+template <bool NothrowMove>
+struct Tracked {
+  static inline int live = 0;
+  static inline int copies = 0;
+  static inline int moves = 0;
+
+  explicit Tracked(int v = 0) : value(v) { ++live; }
+  Tracked(const Tracked &other) : value(other.value) {
+    ++live;
+    ++copies;
+  }
+  Tracked(Tracked &&other) noexcept(NothrowMove) : value(other.value) {
+    ++live;
+    ++moves;
+  }
+  Tracked &operator=(const Tracked &) = default;
+  Tracked &operator=(Tracked &&) = default;
+  ~Tracked() { --live; }
+
+  int value;
+};
+
+}  // namespace
+
+TEST(Vector, Reserve_MovesNothrowElements) {
+  using Item = Tracked<true>;
+  {
+    s21::Vector<Item> v;
+    for (int i = 0; i < 100; ++i) v.push_back(Item(i));
+    ASSERT_EQ(Item::live, 100);
+    Item::copies = Item::moves = 0;
+    v.reserve(1000);
+    ASSERT_EQ(Item::copies, 0);
+    ASSERT_EQ(Item::moves, 100);
+    ASSERT_EQ(Item::live, 100);
+    v.pop_back();
+    v.shrink_to_fit();
+    ASSERT_EQ(v.capacity(), 99);
+    ASSERT_EQ(Item::live, 99);
+    ASSERT_EQ(v[98].value, 98);
+  }
+  ASSERT_EQ(Item::live, 0);
+}
+
+TEST(Vector, Reserve_CopiesWhenMoveMayThrow) {
+  using Item = Tracked<false>;
+  {
+    s21::Vector<Item> v;
+    for (int i = 0; i < 10; ++i) v.push_back(Item(i));
+    Item::copies = Item::moves = 0;
+    v.reserve(100);
+    ASSERT_EQ(Item::copies, 10);
+    ASSERT_EQ(Item::moves, 0);
+    ASSERT_EQ(v[9].value, 9);
+  }
+  ASSERT_EQ(Item::live, 0);
+}
+
+TEST(Vector, Nested_MovesInnerVectors) {
+  static_assert(std::is_nothrow_move_constructible_v<s21::Vector<int>>);
+  s21::Vector<s21::Vector<int>> v;
+  v.push_back(s21::Vector<int>{1, 2, 3});
+  const int *inner = v[0].data();
+  v.reserve(100);
+  ASSERT_EQ(v[0].data(), inner);
+  ASSERT_EQ(v[0][2], 3);
+}
+
+TEST(Vector, Strings_GrowInsertErase) {
+  s21::Vector<std::string> v;
+  for (int i = 0; i < 200; ++i) {
+    v.push_back(std::string(30, static_cast<char>('a' + i % 26)));
+  }
+  v.push_back(v[0]);
+  ASSERT_EQ(v.size(), 201);
+  ASSERT_EQ(v[200], v[0]);
+  v.insert(v.begin() + 1, v[2]);
+  ASSERT_EQ(v[1], std::string(30, 'c'));
+  ASSERT_EQ(v[2], std::string(30, 'b'));
+  v.erase(v.begin());
+  ASSERT_EQ(v[0], std::string(30, 'c'));
+  s21::Vector<std::string> copy(v);
+  ASSERT_EQ(copy.size(), v.size());
+  copy.push_back("tail");
+  ASSERT_EQ(copy[201], "tail");
+  s21::Vector<std::string> empty(3);
+  ASSERT_TRUE(empty[2].empty());
+}
+
+TEST(Vector, MoveOnly_PushBackAndEmplace) {
+  s21::Vector<std::unique_ptr<int>> v;
+  for (int i = 0; i < 10; ++i) v.push_back(std::make_unique<int>(i));
+  v.emplace_back(new int(10));
+  auto it = v.emplace(v.begin() + 2, std::make_unique<int>(-1));
+  ASSERT_EQ(**it, -1);
+  it = v.insert(v.begin(), std::make_unique<int>(-2));
+  ASSERT_TRUE(it == v.begin());
+  ASSERT_EQ(v.size(), 13);
+  int expected[] = {-2, 0, 1, -1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+  for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(*v[i], expected[i]);
+  v.erase(v.begin() + 3);
+  ASSERT_EQ(*v[3], 2);
+  v.insert_many_back(std::make_unique<int>(11), std::make_unique<int>(12));
+  ASSERT_EQ(*v[v.size() - 1], 12);
+}
+
+TEST(Vector, Emplace_ConstructsInPlace) {
+  using Item = Tracked<true>;
+  {
+    s21::Vector<Item> v;
+    v.reserve(4);
+    Item::copies = Item::moves = 0;
+    v.emplace_back(1);
+    v.emplace_back(3);
+    ASSERT_EQ(Item::moves, 0);
+    ASSERT_EQ(v.emplace_back(4).value, 4);
+    v.emplace(v.begin() + 1, 2);
+    ASSERT_EQ(Item::copies, 0);
+    for (int i = 0; i < 4; ++i) ASSERT_EQ(v[i].value, i + 1);
+    v.push_back(Item(5));
+    ASSERT_EQ(Item::copies, 0);
+    ASSERT_EQ(v[4].value, 5);
+  }
+  ASSERT_EQ(Item::live, 0);
+}
+
+TEST(Vector, InsertMany_Forwards) {
+  s21::Vector<std::string> v = {"a", "e"};
+  std::string moved(30, 'c');
+  const std::string copied = "d";
+  auto it = v.insert_many(v.begin() + 1, "b", std::move(moved), copied);
+  ASSERT_EQ(v.size(), 5);
+  ASSERT_TRUE(it == v.begin() + 4);
+  ASSERT_EQ(v[1], "b");
+  ASSERT_EQ(v[2], std::string(30, 'c'));
+  ASSERT_EQ(v[3], "d");
+  ASSERT_EQ(v[4], "e");
+  v.insert_many_back("f", "g");
+  ASSERT_EQ(v[6], "g");
+}
+
+TEST(Vector, InsertMany) {
+  s21::Vector<int> vec = {1, 2, 3, 7, 8};
+  s21::Vector<int>::const_iterator pos = vec.begin() + 3;
+
+  vec.insert_many(pos, 4, 5, 6);
+
+  // Check the size of the vector after insertion
+  ASSERT_EQ(vec.size(), 8);
+
+  // Check the elements after insertion
+  ASSERT_EQ(vec[0], 1);
+  ASSERT_EQ(vec[1], 2);
+  ASSERT_EQ(vec[2], 3);
+  ASSERT_EQ(vec[3], 4);
+  ASSERT_EQ(vec[4], 5);
+  ASSERT_EQ(vec[5], 6);
+  ASSERT_EQ(vec[6], 7);
+  ASSERT_EQ(vec[7], 8);
+}
+
+TEST(Vector, InsertMany_ArgumentsFromSameVector) {
+  s21::Vector<std::string> v = {std::string(30, 'a'), std::string(30, 'b')};
+  v.reserve(8);
+  v.insert_many(v.begin(), v[1], v[0]);
+  ASSERT_EQ(v.size(), 4);
+  ASSERT_EQ(v[0], std::string(30, 'b'));
+  ASSERT_EQ(v[1], std::string(30, 'a'));
+  ASSERT_EQ(v[2], std::string(30, 'a'));
+  ASSERT_EQ(v[3], std::string(30, 'b'));
+}
 
-//   vec.insert_many(pos, 4, 5, 6);
+TEST(Vector, InsertManyBack) {
+  s21::Vector<int> vec = {1, 2, 3};
 
-//   // Check the size of the vector after insertion
-//   ASSERT_EQ(vec.size(), 8);
+  vec.insert_many_back(4, 5, 6);
 
-//   // Check the elements after insertion
-//   ASSERT_EQ(vec[0], 1);
-//   ASSERT_EQ(vec[1], 2);
-//   ASSERT_EQ(vec[2], 3);
-//   ASSERT_EQ(vec[3], 4);
-//   ASSERT_EQ(vec[4], 5);
-//   ASSERT_EQ(vec[5], 6);
-//   ASSERT_EQ(vec[6], 7);
-//   ASSERT_EQ(vec[7], 8);
-// }
+  // Check the size of the vector after insertion
+  ASSERT_EQ(vec.size(), 6);
 
-// TEST(Vector, InsertManyBack) {
-//    s21::Vector<int> vec = {1, 2, 3};
+  // Check the elements after insertion
+  ASSERT_EQ(vec[0], 1);
+  ASSERT_EQ(vec[1], 2);
+  ASSERT_EQ(vec[2], 3);
+  ASSERT_EQ(vec[3], 4);
+  ASSERT_EQ(vec[4], 5);
+  ASSERT_EQ(vec[5], 6);
+}
 
-//   vec.insert_many_back(4, 5, 6);
+TEST(Vector, InsertCount) {
+  s21::Vector<std::string> v = {"a", "b", "c"};
+  v.reserve(10);
+  auto it = v.insert(v.begin() + 1, 2, v[2]);
+  ASSERT_TRUE(it == v.begin() + 1);
+  ASSERT_EQ(v.size(), 5);
+  std::string expected[] = {"a", "c", "c", "b", "c"};
+  for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(v[i], expected[i]);
+  v.insert(v.begin() + 2, 20, std::string(30, 'x'));
+  ASSERT_EQ(v.size(), 25);
+  ASSERT_EQ(v[21], std::string(30, 'x'));
+  ASSERT_EQ(v[22], "c");
+  ASSERT_TRUE(v.insert(v.end(), 0, "z") == v.end());
+}
+
+TEST(Vector, InsertRange) {
+  s21::Vector<int> v = {1, 6};
+  std::vector<int> mid = {2, 3};
+  std::list<int> more = {4, 5};
+  v.insert(v.begin() + 1, mid.begin(), mid.end());
+  auto it = v.insert(v.begin() + 3, more.begin(), more.end());
+  ASSERT_EQ(*it, 4);
+  std::istringstream in("7 8 9");
+  v.insert(v.end(), std::istream_iterator<int>(in),
+           std::istream_iterator<int>());
+  s21::List<int> front = {-1, 0};
+  v.insert(v.begin(), front.begin(), front.end());
+  ASSERT_EQ(v.size(), 11);
+  for (int i = 0; i < 11; ++i) ASSERT_EQ(v[i], i - 1);
+}
+
+TEST(Vector, InsertMany_ShiftsTailOnce) {
+  s21::Vector<std::string> v = {"a", "e", "f"};
+  v.reserve(8);
+  auto it = v.insert_many(v.begin() + 1, "b", "c", "d");
+  ASSERT_TRUE(it == v.begin() + 4);
+  v.insert_many(v.begin() + 5, "x", "y", "z");
+  std::string expected[] = {"a", "b", "c", "d", "e", "x", "y", "z", "f"};
+  ASSERT_EQ(v.size(), 9);
+  for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(v[i], expected[i]);
+}
+
+namespace {
+
+// Бросает исключение при копировании, когда счетчик доходит до нуля.
+struct ThrowingCopy {
+  static inline int budget = -1;
+  explicit ThrowingCopy(int v) : value(v) {}
+  ThrowingCopy(const ThrowingCopy &other) : value(other.value) {
+    if (budget-- == 0) throw std::runtime_error("copy");
+  }
+  ThrowingCopy(ThrowingCopy &&other) noexcept = default;
+  ThrowingCopy &operator=(const ThrowingCopy &other) = default;
+  ThrowingCopy &operator=(ThrowingCopy &&other) noexcept = default;
+  std::string value_holder = std::string(20, 'h');
+  int value;
+};
+
+}  // namespace
+
+TEST(Vector, InsertRange_RestoresTailOnThrow) {
+  s21::Vector<ThrowingCopy> v;
+  v.reserve(10);
+  for (int i = 0; i < 4; ++i) v.emplace_back(i);
+  std::vector<ThrowingCopy> items = {ThrowingCopy(10), ThrowingCopy(11),
+                                     ThrowingCopy(12)};
+  ThrowingCopy::budget = 2;
+  ASSERT_THROW(v.insert(v.begin() + 1, items.begin(), items.end()),
+               std::runtime_error);
+  ThrowingCopy::budget = -1;
+  ASSERT_EQ(v.size(), 4);
+  for (int i = 0; i < 4; ++i) ASSERT_EQ(v[i].value, i);
+}
 
-//   // Check the size of the vector after insertion
-//   ASSERT_EQ(vec.size(), 6);
+TEST(Vector, EraseRange) {
+  s21::Vector<std::string> v = {"a", "b", "c", "d", "e", "f"};
+  auto it = v.erase(v.begin() + 1, v.begin() + 3);
+  ASSERT_EQ(*it, "d");
+  ASSERT_EQ(v.size(), 4);
+  ASSERT_EQ(v[1], "d");
+  ASSERT_EQ(v[3], "f");
+  ASSERT_TRUE(v.erase(v.begin() + 2, v.begin() + 2) == v.begin() + 2);
+  ASSERT_THROW(v.erase(v.begin() + 3, v.begin() + 1), std::out_of_range);
+  it = v.erase(v.begin() + 2, v.end());
+  ASSERT_TRUE(it == v.end());
+  ASSERT_EQ(v.size(), 2);
 
-//   // Check the elements after insertion
-//   ASSERT_EQ(vec[0], 1);
-//   ASSERT_EQ(vec[1], 2);
-//   ASSERT_EQ(vec[2], 3);
-//   ASSERT_EQ(vec[3], 4);
-//   ASSERT_EQ(vec[4], 5);
-//   ASSERT_EQ(vec[5], 6);
-// }
\ No newline at end of file
+  s21::Vector<int> ints = {0, 1, 2, 3, 4, 5, 6, 7};
+  ints.erase(ints.begin(), ints.begin() + 5);
+  ASSERT_EQ(ints.size(), 3);
+  ASSERT_EQ(ints[0], 5);
+  ASSERT_EQ(ints[2], 7);
+}
+
+TEST(Vector, EraseIf) {
+  s21::Vector<int> ints;
+  for (int i = 0; i < 100; ++i) ints.push_back(i);
+  ASSERT_EQ(s21::erase_if(ints, [](int x) { return x % 3 != 0; }), 66);
+  ASSERT_EQ(ints.size(), 34);
+  for (int i = 0; i < 34; ++i) ASSERT_EQ(ints[i], i * 3);
+  ASSERT_EQ(s21::erase_if(ints, [](int) { return false; }), 0);
+  ASSERT_EQ(s21::erase_if(ints, [](int) { return true; }), 34);
+  ASSERT_TRUE(ints.empty());
+
+  using Item = Tracked<true>;
+  {
+    s21::Vector<Item> items;
+    for (int i = 0; i < 10; ++i) items.emplace_back(i);
+    int calls = 0;
+    auto odd = [&calls](const Item &item) {
+      ++calls;
+      return item.value % 2 == 1;
+    };
+    ASSERT_EQ(s21::erase_if(items, odd), 5);
+    ASSERT_EQ(calls, 10);
+    ASSERT_EQ(Item::live, 5);
+    for (int i = 0; i < 5; ++i) ASSERT_EQ(items[i].value, i * 2);
+  }
+  ASSERT_EQ(Item::live, 0);
+
+  s21::Vector<std::unique_ptr<int>> owned;
+  for (int i = 0; i < 6; ++i) owned.push_back(std::make_unique<int>(i));
+  s21::erase_if(owned, [](const std::unique_ptr<int> &p) { return *p < 3; });
+  ASSERT_EQ(owned.size(), 3);
+  ASSERT_EQ(*owned[0], 3);
+}
+
+TEST(Vector, EraseIf_ThrowingPredicate) {
+  s21::Vector<std::unique_ptr<int>> owned;
+  for (int i = 0; i < 8; ++i) owned.push_back(std::make_unique<int>(i));
+  int calls = 0;
+  auto even = [&calls](const std::unique_ptr<int> &p) {
+    if (++calls == 4) throw std::runtime_error("predicate");
+    return *p % 2 == 0;
+  };
+  ASSERT_THROW(s21::erase_if(owned, even), std::runtime_error);
+  ASSERT_EQ(owned.size(), 6);
+  const int expected[] = {1, 3, 4, 5, 6, 7};
+  for (int i = 0; i < 6; ++i) ASSERT_EQ(*owned[i], expected[i]);
+}
+
+namespace {
+
+// Держит объект в куче; перенос байтами для него безопасен.
+struct Boxed {
+  static inline int live = 0;
+  static inline int moves = 0;
+
+  explicit Boxed(int v) : value(new int(v)) { ++live; }
+  Boxed(Boxed &&other) noexcept : value(other.value) {
+    other.value = nullptr;
+    ++live;
+    ++moves;
+  }
+  Boxed &operator=(Boxed &&other) noexcept {
+    std::swap(value, other.value);
+    return *this;
+  }
+  ~Boxed() {
+    delete value;
+    --live;
+  }
+
+  int *value;
+};
+
+}  // namespace
+
+namespace s21 {
+template <>
+struct is_trivially_relocatable<Boxed> : std::true_type {};
+}  // namespace s21
+
+TEST(Vector, TriviallyRelocatable_SkipsMoves) {
+  static_assert(s21::is_trivially_relocatable_v<int>);
+  static_assert(s21::is_trivially_relocatable_v<std::unique_ptr<int>>);
+  static_assert(!s21::is_trivially_relocatable_v<std::string>);
+  {
+    s21::Vector<Boxed> v;
+    std::vector<int> expected;
+    for (int i = 0; i < 100; ++i) {
+      v.emplace_back(i);
+      expected.push_back(i);
+    }
+    v.reserve(500);
+    ASSERT_EQ(Boxed::moves, 0);
+    v.emplace(v.begin(), -1);
+    expected.insert(expected.begin(), -1);
+    v.insert_many(v.begin() + 50, 1000, 1001);
+    expected.insert(expected.begin() + 50, {1000, 1001});
+    v.erase(v.begin() + 1);
+    expected.erase(expected.begin() + 1);
+    v.erase(v.begin() + 10, v.begin() + 20);
+    expected.erase(expected.begin() + 10, expected.begin() + 20);
+    s21::erase_if(v, [](const Boxed &b) { return *b.value % 2 == 1; });
+    expected.erase(std::remove_if(expected.begin(), expected.end(),
+                                  [](int x) { return x % 2 == 1; }),
+                   expected.end());
+    v.shrink_to_fit();
+    ASSERT_EQ(Boxed::live, static_cast<int>(v.size()));
+    ASSERT_EQ(v.size(), expected.size());
+    for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(*v[i].value, expected[i]);
+  }
+  ASSERT_EQ(Boxed::live, 0);
+}
@@ -1,26 +1,119 @@
 #ifndef S21_TREE_H
 #define S21_TREE_H
 
+#include <cstddef>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
+#include "../allocator/slab_allocator.h"
 #include "../vector/vector.h"
 
 namespace s21 {
+// Отсекает конструкторы от пары итераторов для аргументов вроде {2, 2}.
+template <typename InputIt>
+using EnableIfIterator = std::enable_if_t<!std::is_integral_v<InputIt>>;
+
+// Поиск по ключу другого типа (std::string_view для ключей std::string)
+// разрешен, только если компаратор прозрачный, как std::less<>.
+// Проверка идет через Key, чтобы подстановка не падала при инстанцировании
+// класса с обычным компаратором.
+template <typename Comp, typename Key, typename = void>
+struct TransparentKey {};
+
+template <typename Comp, typename Key>
+struct TransparentKey<Comp, Key, std::void_t<typename Comp::is_transparent>> {
+  using type = void;
+};
+
+template <typename Comp, typename Key>
+using EnableIfTransparent = typename TransparentKey<Comp, Key>::type;
+
+// Строки под std::less сравниваются одним вызовом compare(), который сразу
+// дает знак; остальные ключи - двумя вызовами компаратора.
+template <typename Comp, typename K>
+struct StringCompare : std::false_type {};
+
+template <typename Comp, typename C, typename T, typename A>
+struct StringCompare<Comp, std::basic_string<C, T, A>>
+    : std::bool_constant<
+          std::is_same_v<Comp, std::less<>> ||
+          std::is_same_v<Comp, std::less<std::basic_string<C, T, A>>>> {
+  using view_type = std::basic_string_view<C, T>;
+};
+
+// Политики узла. OrderStatistics хранит в каждом узле размер его поддерева:
+// rank, select и арифметика итераторов работают за O(log n) ценой одного
+// size_t на узел и пересчета размеров при вставке, удалении и поворотах.
+struct NoOrderStatistics {
+  static constexpr bool kEnabled = false;
+};
+struct OrderStatistics {
+  static constexpr bool kEnabled = true;
+};
+
+// Раскладка значения в узле. Узел словаря хранит пару ключ-значение, узел
+// множества (V = void) - только ключ, он же и значение.
 template <typename K, typename V>
+struct TreeValueTraits {
+  using value_type = std::pair<const K, V>;
+  using mapped_type = V;
+  static const K &key(const value_type &value) noexcept { return value.first; }
+  static V &mapped(value_type &value) noexcept { return value.second; }
+};
+
+template <typename K>
+struct TreeValueTraits<K, void> {
+  using value_type = const K;
+  using mapped_type = const K;
+  static const K &key(const K &value) noexcept { return value; }
+  static const K &mapped(const K &value) noexcept { return value; }
+};
+
+template <bool Enabled>
+struct SubtreeSize {};
+template <>
+struct SubtreeSize<true> {
+  size_t count_ = 1;
+};
+
+// V = void makes a key-only tree for Set and Multiset: nodes store the key
+// once and value_type is const K.
+template <typename K, typename V, typename Comp = std::less<>,
+          typename Alloc = SlabAllocator<std::remove_const_t<
+              typename TreeValueTraits<K, V>::value_type>>,
+          typename Stats = NoOrderStatistics>
 class Tree {
  public:
   using key_type = K;
-  using mapped_type = V;
-  using value_type = std::pair<const key_type, mapped_type>;
+  using mapped_type = typename TreeValueTraits<K, V>::mapped_type;
+  using value_type = typename TreeValueTraits<K, V>::value_type;
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare = Comp;
+  using allocator_type = Alloc;
+  using tree_type = Tree;
 
   Tree() noexcept;
+  explicit Tree(const allocator_type &alloc);
+  explicit Tree(const key_compare &comp,
+                const allocator_type &alloc = allocator_type());
   explicit Tree(const value_type &elem) noexcept;
   Tree(std::initializer_list<value_type> const &items);
+  template <typename InputIt, typename = EnableIfIterator<InputIt>>
+  Tree(InputIt first, InputIt last);
   Tree(const Tree &other) noexcept;
   Tree(Tree &&other) noexcept;
   ~Tree();
@@ -33,32 +126,186 @@ class Tree {
   size_type max_size() const noexcept;
 
   mapped_type &at(const key_type &key);
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  mapped_type &at(const Key &key);
   mapped_type &operator[](const key_type &key);
+  mapped_type &operator[](key_type &&key);
+
+  allocator_type get_allocator() const noexcept;
+  key_compare key_comp() const;
 
   void clear() noexcept;
   void swap(Tree &other);
-  void merge(Tree<K, V> &other);
+  void merge(Tree<K, V, Comp, Alloc, Stats> &other);
+
+  // Replaces the contents with [first, last), which should be sorted by key.
+  // Sorted input is linked into a perfectly balanced tree in O(n); once an
+  // out-of-order element shows up the rest is inserted one by one.
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last);
+
+  enum class SetOperation {
+    kUnion,
+    kIntersection,
+    kDifference,
+    kSymmetricDifference
+  };
+  // Replaces the contents with op applied to a and b. Both trees are walked
+  // in order once, so this is O(n + m). Equal keys are matched one to one,
+  // as in std::set_union and friends, and values are taken from a.
+  void assign_set_operation(const Tree &a, const Tree &b, SetOperation op);
+
+  // In-place set operations for trees with unique keys, built on split and
+  // join: O(m log(n / m + 1)) work for sizes n >= m, and the independent
+  // halves run on up to threads threads (0 means hardware_concurrency()).
+  // other is left empty; each of its nodes is moved here or freed. A
+  // multiset falls back to assign_set_operation.
+  void union_with(Tree &other, unsigned threads = 0);
+  void intersect_with(Tree &other, unsigned threads = 0);
+  void difference_with(Tree &other, unsigned threads = 0);
+  void symmetric_difference_with(Tree &other, unsigned threads = 0);
   // bool contains(const key_type &key) const noexcept;
 
  protected:
-  typedef struct Node {
+  enum Color { kRed, kBlack };
+  using value_traits = TreeValueTraits<K, V>;
+
+  // Связи узла вынесены в базу, чтобы заголовок (header_) не хранил
+  // value_type: header_.parent_ - корень, left_/right_ - минимум и максимум.
+  typedef struct NodeBase : SubtreeSize<Stats::kEnabled> {
+    NodeBase *parent_ = nullptr;
+    NodeBase *left_ = nullptr;
+    NodeBase *right_ = nullptr;
+    Color color_ = kRed;
+  } NodeBase;
+
+  typedef struct Node : NodeBase {
     value_type data_ = value_type{};
-    Node *parent_ = nullptr;
-    Node *left_ = nullptr;
-    Node *right_ = nullptr;
 
-    Node(const value_type &elem) : data_(elem) {}
+    template <typename... Args>
+    explicit Node(Args &&...args) : data_(std::forward<Args>(args)...) {}
     ~Node() = default;
+
+    const key_type &key() const noexcept { return value_traits::key(data_); }
   } Node;
 
-  void insert_(Node *&root_, K key, V value);
-  void push_(K key, V value);
+  using node_allocator_type =
+      typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator_type>;
+
+  template <typename... Args>
+  Node *create_node_(Args &&...args);
+  void destroy_node_(Node *node) noexcept;
+  void destroy_values_(NodeBase *node) noexcept;
+
+  std::pair<NodeBase *, bool> find_insert_pos_(const key_type &key,
+                                               bool &to_left) const noexcept;
+  Node *link_node_(Node *node, NodeBase *parent, bool to_left) noexcept;
   bool contains(const key_type &key) const noexcept;
-  void clear_node(Node *node);
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  bool contains(const Key &key) const noexcept;
+  void clear_node(NodeBase *node);
+  template <typename Key>
+  Node *find_node_(const Key &key) const noexcept;
+  template <typename Key>
+  NodeBase *lower_bound_node_(const Key &key) const noexcept;
+  template <typename Key>
+  NodeBase *upper_bound_node_(const Key &key) const noexcept;
+  template <typename A, typename B>
+  int compare_(const A &a, const B &b) const;
+
+  static Node *as_node_(NodeBase *node) noexcept;
+  static NodeBase *next_(NodeBase *node) noexcept;
+  static NodeBase *prev_(NodeBase *node) noexcept;
+  NodeBase *root_() const noexcept;
+  void reset_header_() noexcept;
+  void fix_header_() noexcept;
+
+  static bool is_red_(const NodeBase *node) noexcept;
+  static size_type subtree_size_(const NodeBase *node) noexcept;
+  static void update_size_(NodeBase *node) noexcept;
+  size_type index_of_(const NodeBase *node) const noexcept;
+  void rotate_left_(NodeBase *node) noexcept;
+  void rotate_right_(NodeBase *node) noexcept;
+  void transplant_(NodeBase *node, NodeBase *child) noexcept;
+  NodeBase *unlink_node_(NodeBase *node) noexcept;
+  bool share_allocator_(Tree &other, bool &adopted) noexcept;
+  void unshare_allocator_(Tree &other, node_allocator_type own) noexcept;
+  node_allocator_type fresh_allocator_() const;
+  void insert_fixup_(NodeBase *node) noexcept;
+  void erase_fixup_(NodeBase *node, NodeBase *parent) noexcept;
+
+  // Копирование структуры: узлы назначения переиспользуются через пул, а
+  // большие деревья копируются по поддеревьям в нескольких потоках.
+  static constexpr size_type kParallelCloneSize = size_type(1) << 16;
+  static constexpr bool kParallelClone =
+      std::is_same_v<node_allocator_type, SlabAllocator<Node>> ||
+      std::allocator_traits<node_allocator_type>::is_always_equal::value;
+
+  void assign_clone_(const Tree &other);
+  static void detach_(NodeBase *node, NodeBase *&pool) noexcept;
+  Node *reuse_node_(NodeBase *&pool, const value_type &elem);
+  NodeBase *clone_(const NodeBase *src, NodeBase *parent, NodeBase *&pool);
+  static NodeBase *clone_parallel_(const NodeBase *src,
+                                   node_allocator_type &alloc, int depth);
+  static size_type destroy_subtree_(NodeBase *node,
+                                    node_allocator_type &alloc) noexcept;
+  static int fork_depth_(unsigned threads) noexcept;
+  void attach_root_(NodeBase *root, size_type size) noexcept;
+
+  // Split и join над отсоединенными поддеревьями. Черная высота - число
+  // черных узлов на пути от корня поддерева до листа; корень может быть
+  // красным, его перекрашивают при подвешивании к заголовку.
+  struct Subtree {
+    NodeBase *root_;
+    int black_height_;
+  };
+  // Выброшенные поддеревья: цепочка через parent_ их корней.
+  struct Garbage {
+    NodeBase *head_ = nullptr;
+    NodeBase *tail_ = nullptr;
+    void push(NodeBase *node) noexcept;
+    void append(Garbage &other) noexcept;
+  };
+  // Половины делятся между потоками, пока в поддереве не меньше 2^10 узлов.
+  static constexpr int kParallelJoinHeight = 10;
+
+  static int black_height_(const NodeBase *root) noexcept;
+  Subtree detach_root_() noexcept;
+  static void set_children_(NodeBase *node, NodeBase *left,
+                            NodeBase *right) noexcept;
+  static NodeBase *rotate_sub_left_(NodeBase *node) noexcept;
+  static NodeBase *rotate_sub_right_(NodeBase *node) noexcept;
+  static NodeBase *join_right_(NodeBase *left, int left_height,
+                               NodeBase *pivot, NodeBase *right,
+                               int right_height) noexcept;
+  static NodeBase *join_left_(NodeBase *left, int left_height,
+                              NodeBase *pivot, NodeBase *right,
+                              int right_height) noexcept;
+  static Subtree join_(Subtree left, NodeBase *pivot, Subtree right) noexcept;
+  static Subtree join2_(Subtree left, Subtree right) noexcept;
+  static Subtree split_last_(Subtree tree, NodeBase *&last) noexcept;
+  Subtree split_(Subtree tree, const key_type &key, NodeBase *&found,
+                 Subtree &right) const;
+  Subtree combine_(Subtree a, Subtree b, SetOperation op, Garbage &garbage,
+                   int depth) const;
+  size_type destroy_garbage_(Garbage &garbage) noexcept;
+  void combine_with_(Tree &other, SetOperation op, unsigned threads);
+
+  // Слияние обходом обоих деревьев и пересборкой, если other не намного
+  // меньше этого дерева; иначе узлы вставляются по одному.
+  static constexpr size_type kLinearMergeRatio = 8;
+  void merge_linear_(Tree &other);
+
+  template <typename Elem>
+  Node *create_from_(Elem &&elem);
+  void link_sorted_(Vector<Node *> &nodes) noexcept;
+  NodeBase *build_balanced_(Vector<Node *> &nodes, size_type first,
+                            size_type last, int depth, int red_depth) noexcept;
 
   class Iterator {
    public:
-    Iterator(Node *first, const Tree<K, V> &second) noexcept
+    Iterator(NodeBase *first, const Tree &second) noexcept
         : current_(first), tree_(&second) {}
     Iterator(const Iterator &other) {
       current_ = other.current_;
@@ -72,11 +319,16 @@ class Tree {
     bool operator!=(const Iterator &other) {
       return this->current_ != other.current_;
     }
-    value_type *operator->() { return &(current_->data_); }
+    value_type *operator->() { return &(as_node_(current_)->data_); }
     key_type operator*() {
       // return current_ ? current_->data_ : const_reference{};
-      return current_ ? current_->data_.first
-                      : static_cast<key_type>(tree_->size());
+      if (current_ != &tree_->header_) return as_node_(current_)->key();
+      // как и у std::set, *end() для чисел дает количество элементов
+      if constexpr (std::is_arithmetic_v<key_type>) {
+        return static_cast<key_type>(tree_->size());
+      } else {
+        return key_type{};
+      }
     }
 
     Iterator operator++();
@@ -84,444 +336,2137 @@ class Tree {
     Iterator operator--();
     Iterator operator--(int);
 
+    // Random access in O(log n), with the OrderStatistics policy only.
+    Iterator operator+(difference_type n) const;
+    Iterator operator-(difference_type n) const;
+    Iterator &operator+=(difference_type n);
+    Iterator &operator-=(difference_type n);
+    difference_type operator-(const Iterator &other) const;
+
     Iterator operator=(const Iterator &other) {
       current_ = other.current_;
+      tree_ = other.tree_;
       return *this;
     }
 
-    Node *Get() { return current_; }
+    NodeBase *Get() { return current_; }
 
    protected:
-    Node *current_;
-    const Tree<K, V> *tree_;
+    NodeBase *current_;
+    const Tree<K, V, Comp, Alloc, Stats> *tree_;
+  };
+
+  // Узел, извлеченный из дерева, вместе с копией аллокатора, которым он
+  // был выделен. Пустой handle не создает аллокатор.
+  class NodeHandle {
+   public:
+    using key_type = K;
+    using mapped_type = typename Tree::mapped_type;
+    using allocator_type = Alloc;
+
+    NodeHandle() noexcept = default;
+    NodeHandle(NodeHandle &&other) noexcept;
+    NodeHandle &operator=(NodeHandle &&other) noexcept;
+    ~NodeHandle() { reset_(); }
+
+    bool empty() const noexcept { return node_ == nullptr; }
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+    allocator_type get_allocator() const { return allocator_type(*alloc_); }
+    // Ключ только для чтения: в узле он хранится как const key_type.
+    const key_type &key() const { return node_->key(); }
+    mapped_type &mapped() const { return value_traits::mapped(node_->data_); }
 
    private:
-    void increase_();
-    void decrease_();
-    Node *find_parent_(Node *node);
-    Node *find_leftmost_(Node *node);
-    Node *find_rightmost_(Node *node);
-    Node *max_();
-    Node *min_();
+    friend class Tree;
+
+    NodeHandle(Node *node, const node_allocator_type &alloc)
+        : node_(node), alloc_(alloc) {}
+    void reset_() noexcept;
+
+    Node *node_ = nullptr;
+    std::optional<node_allocator_type> alloc_;
   };
 
-  Iterator find_pos_(const key_type &key) noexcept;
+  template <typename Key>
+  Iterator find_pos_(const Key &key) noexcept;
+  std::pair<Iterator, bool> insert_value_(const value_type &value);
+  // У множества value_type - const K, из которого нельзя переместить.
+  std::pair<Iterator, bool> insert_value_(
+      std::remove_const_t<value_type> &&value);
+  template <typename... Args>
+  std::pair<Iterator, bool> emplace_(Args &&...args);
+  template <typename Key, typename... Args>
+  std::pair<Iterator, bool> try_emplace_(Key &&key, Args &&...args);
   bool is_multi_set = false;
 
  public:
   using const_iterator = const Iterator;
   using iterator = Iterator;
+  using node_type = NodeHandle;
+
+  struct insert_return_type {
+    iterator position;
+    bool inserted;
+    node_type node;
+  };
 
   iterator begin() const;
   iterator end() const;
   void erase(iterator pos);
 
+  // Bound searches descend from the root once: O(log n). The Key overloads
+  // take any type comparable with key_type when the comparator is
+  // transparent, e.g. std::string_view for std::string keys.
+  iterator lower_bound(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  iterator lower_bound(const Key &key) const;
+  iterator upper_bound(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  iterator upper_bound(const Key &key) const;
+  std::pair<iterator, iterator> equal_range(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  std::pair<iterator, iterator> equal_range(const Key &key) const;
+  // O(log n + k) for k matching elements, O(log n) with OrderStatistics.
+  size_type count(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  size_type count(const Key &key) const;
+
+  // Order statistics, available with the OrderStatistics policy; all are
+  // O(log n). rank is the number of elements less than key, select(k) and
+  // nth(k) return the k-th element in order (0-based) or end().
+  size_type rank(const key_type &key) const;
+  template <typename Key, typename = EnableIfTransparent<Comp, Key>>
+  size_type rank(const Key &key) const;
+  iterator select(size_type k) const;
+  iterator nth(size_type k) const;
+
+  // Unlinks the element from the tree without freeing or copying it.
+  node_type extract(iterator pos);
+  node_type extract(const key_type &key);
+
+  // Moves the elements greater than key into right, dropping its previous
+  // contents, and returns the element equal to key, if any; this tree keeps
+  // the smaller ones. O(log n + min(|this|, |right|)): the smaller half is
+  // counted. In a multiset the first equal element is returned and the rest
+  // go to right.
+  node_type split(const key_type &key, Tree &right);
+  // Replaces the contents with left, pivot and right concatenated in
+  // O(log n). Keys of left must precede the pivot and keys of right follow
+  // it; an empty pivot concatenates left and right. Both are left empty.
+  void join(Tree &left, node_type &&pivot, Tree &right);
+
   template <class... Args>
-  Vector<std::pair<typename Tree<key_type, mapped_type>::iterator, bool>>
+  Vector<std::pair<typename Tree<K, V, Comp, Alloc, Stats>::iterator, bool>>
   insert_many(Args &&...args);
 
+ protected:
+  insert_return_type insert_node_(node_type &&handle);
+  template <typename Key>
+  std::pair<iterator, iterator> equal_range_(const Key &key) const;
+  template <typename Key>
+  size_type count_equal_(const Key &key) const;
+
  private:
-  Node *root_ = nullptr;
+  key_compare comp_;
+  node_allocator_type alloc_;
+  NodeBase header_{{}, nullptr, &header_, &header_, kRed};
   size_type size_ = 0;
   size_type max_size_;
 };
 
-template <typename K, typename V>
-Tree<K, V>::Tree() noexcept {}
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+Tree<K, V, Comp, Alloc, Stats>::Tree() noexcept {}
 
-template <typename K, typename V>
-Tree<K, V>::Tree(const value_type &elem) noexcept {
-  push_(elem.first, elem.second);
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+Tree<K, V, Comp, Alloc, Stats>::Tree(const allocator_type &alloc)
+    : alloc_(alloc) {}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+Tree<K, V, Comp, Alloc, Stats>::Tree(const key_compare &comp,
+                                     const allocator_type &alloc)
+    : comp_(comp), alloc_(alloc) {}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+Tree<K, V, Comp, Alloc, Stats>::Tree(const value_type &elem) noexcept {
+  insert_value_(elem);
 }
 
-template <typename K, typename V>
-Tree<K, V>::Tree(const std::initializer_list<value_type> &items) {
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+Tree<K, V, Comp, Alloc, Stats>::Tree(
+    const std::initializer_list<value_type> &items) {
   if (items.size() == 0) return;
-  for (auto &item : items) {
-    push_(item.first, item.second);
-  }
+  assign_sorted(items.begin(), items.end());
 }
 
-template <typename K, typename V>
-Tree<K, V>::Tree(const Tree &other) noexcept {
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename InputIt, typename>
+Tree<K, V, Comp, Alloc, Stats>::Tree(InputIt first, InputIt last) {
+  assign_sorted(first, last);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+Tree<K, V, Comp, Alloc, Stats>::Tree(const Tree &other) noexcept
+    : comp_(other.comp_),
+      alloc_(node_traits::select_on_container_copy_construction(other.alloc_)) {
   *this = other;
 }
 
-template <typename K, typename V>
-Tree<K, V>::Tree(Tree &&other) noexcept {
-  // *this = std::move(other);
+// Перемещенное дерево получает новый аллокатор: иначе оно делило бы с этим
+// деревом непотокобезопасную арену.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+Tree<K, V, Comp, Alloc, Stats>::Tree(Tree &&other) noexcept
+    : comp_(other.comp_),
+      alloc_(node_traits::select_on_container_copy_construction(other.alloc_)) {
   this->swap(other);
 }
 
-template <typename K, typename V>
-Tree<K, V>::~Tree() {
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+Tree<K, V, Comp, Alloc, Stats>::~Tree() {
   clear();
 }
 
-template <typename K, typename V>
-Tree<K, V> &Tree<K, V>::operator=(const Tree &other) noexcept {
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+Tree<K, V, Comp, Alloc, Stats> &
+Tree<K, V, Comp, Alloc, Stats>::operator=(const Tree &other) noexcept {
   if (this != &other) {
-    // this->clear();
-    for (iterator it = other.begin(); it != other.end(); it++) {
-      this->push_(it->first, it->second);
-    }
+    comp_ = other.comp_;
+    assign_clone_(other);
   }
   return *this;
 }
 
-template <typename K, typename V>
-Tree<K, V> &Tree<K, V>::operator=(Tree &&other) noexcept {
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+Tree<K, V, Comp, Alloc, Stats> &
+Tree<K, V, Comp, Alloc, Stats>::operator=(Tree &&other) noexcept {
   if (this != &other) {
-    root_ = other.root_;
-    this->size_ = other.size_;
-    other.clear();
+    clear();
+    swap(other);
   }
   return *this;
 }
 
-template <typename K, typename V>
-typename Tree<K, V>::size_type Tree<K, V>::size() const noexcept {
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::size_type
+Tree<K, V, Comp, Alloc, Stats>::size() const noexcept {
   return size_;
 }
 
-template <typename K, typename V>
-void Tree<K, V>::clear() noexcept {
-  if (root_ != nullptr) {
-    clear_node(root_);
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::allocator_type
+Tree<K, V, Comp, Alloc, Stats>::get_allocator() const noexcept {
+  return allocator_type(alloc_);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::key_compare
+Tree<K, V, Comp, Alloc, Stats>::key_comp() const {
+  return comp_;
+}
+
+// Если арена принадлежит только этому дереву, узлы не возвращаются в нее
+// по одному: значения разрушаются, а блоки освобождаются целиком.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::clear() noexcept {
+  if (root_() != nullptr) {
+    if constexpr (is_releasable_allocator<node_allocator_type>::value) {
+      if (alloc_.can_release()) {
+        destroy_values_(root_());
+        alloc_.release();
+      } else {
+        clear_node(root_());
+      }
+    } else {
+      clear_node(root_());
+    }
   }
-  root_ = nullptr;
+  reset_header_();
   size_ = 0;
 }
 
-template <typename K, typename V>
-inline void Tree<K, V>::swap(Tree &other) {
-  std::swap(root_, other.root_);
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline void Tree<K, V, Comp, Alloc, Stats>::swap(Tree &other) {
+  std::swap(comp_, other.comp_);
+  std::swap(alloc_, other.alloc_);
+  std::swap(header_, other.header_);
   std::swap(size_, other.size_);
   std::swap(max_size_, other.max_size_);
+  fix_header_();
+  other.fix_header_();
 }
 
-template <typename K, typename V>
-inline void Tree<K, V>::erase(iterator pos) {
-  Node *cur = pos.Get();
-  if (cur->left_ == nullptr && cur->right_ == nullptr &&
-      cur->parent_ == nullptr) {
-    delete cur;
-    root_ = nullptr;
-    size_--;
-    return;
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline void Tree<K, V, Comp, Alloc, Stats>::erase(iterator pos) {
+  destroy_node_(as_node_(unlink_node_(pos.Get())));
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::node_type
+Tree<K, V, Comp, Alloc, Stats>::extract(iterator pos) {
+  return node_type(as_node_(unlink_node_(pos.Get())), alloc_);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::node_type
+Tree<K, V, Comp, Alloc, Stats>::extract(const key_type &key) {
+  Node *node = find_node_(key);
+  if (node == nullptr) return node_type();
+  return node_type(as_node_(unlink_node_(node)), alloc_);
+}
+
+// Исключает узел из дерева с балансировкой, но не освобождает его: узел
+// возвращается без связей и красным, как только что созданный.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *
+Tree<K, V, Comp, Alloc, Stats>::unlink_node_(NodeBase *cur) noexcept {
+  if (cur == header_.left_) {
+    header_.left_ = next_(cur);
   }
-  if (cur->left_ == nullptr && cur->right_ == nullptr) {
-    // если нет детей
-    if (cur->parent_->left_ == cur) {
-      cur->parent_->left_ = nullptr;
-    } else {
-      cur->parent_->right_ = nullptr;
-    }
-    delete cur;
-    size_--;
-  } else if (cur->left_ != nullptr && cur->right_ != nullptr) {
-    // если есть оба ребенка... и ипотека
-    Node *min = cur->right_;
-    while (min->left_ != nullptr) {
-      min = min->left_;
-    }
-    min->parent_ = cur->parent_;
-    min->left_ = cur->left_;
-    if (min != cur->right_) {
-      min->right_ = cur->right_;
+  if (cur == header_.right_) {
+    header_.right_ = prev_(cur);
+  }
+  NodeBase *removed = cur;
+  Color removed_color = removed->color_;
+  NodeBase *child;
+  NodeBase *child_parent;
+  if (cur->left_ == nullptr) {
+    child = cur->right_;
+    child_parent = cur->parent_;
+    transplant_(cur, cur->right_);
+  } else if (cur->right_ == nullptr) {
+    child = cur->left_;
+    child_parent = cur->parent_;
+    transplant_(cur, cur->left_);
+  } else {
+    // если есть оба ребенка, на место cur встает минимум правого поддерева
+    removed = cur->right_;
+    while (removed->left_ != nullptr) {
+      removed = removed->left_;
+    }
+    removed_color = removed->color_;
+    child = removed->right_;
+    if (removed->parent_ == cur) {
+      child_parent = removed;
     } else {
-      min->right_ = nullptr;
+      child_parent = removed->parent_;
+      transplant_(removed, removed->right_);
+      removed->right_ = cur->right_;
+      removed->right_->parent_ = removed;
     }
-    if (cur->parent_->left_ == cur) {
-      cur->parent_->left_ = min;
+    transplant_(cur, removed);
+    removed->left_ = cur->left_;
+    removed->left_->parent_ = removed;
+    removed->color_ = cur->color_;
+  }
+  size_--;
+  if constexpr (Stats::kEnabled) {
+    // все узлы с изменившимся поддеревом лежат на пути от child_parent
+    for (NodeBase *node = child_parent; node != &header_;
+         node = node->parent_) {
+      update_size_(node);
+    }
+    cur->count_ = 1;
+  }
+  if (removed_color == kBlack) {
+    erase_fixup_(child, child_parent);
+  }
+  cur->parent_ = nullptr;
+  cur->left_ = nullptr;
+  cur->right_ = nullptr;
+  cur->color_ = kRed;
+  return cur;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+bool Tree<K, V, Comp, Alloc, Stats>::empty() const noexcept {
+  return !root_();
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::size_type
+Tree<K, V, Comp, Alloc, Stats>::max_size() const noexcept {
+  return std::numeric_limits<size_type>::max() / sizeof(Node) / 6;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::mapped_type &
+Tree<K, V, Comp, Alloc, Stats>::at(const key_type &key) {
+  Node *node = find_node_(key);
+  if (node == nullptr) {
+    throw std::out_of_range("Key not found");
+  }
+  return value_traits::mapped(node->data_);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key, typename>
+inline typename Tree<K, V, Comp, Alloc, Stats>::mapped_type &
+Tree<K, V, Comp, Alloc, Stats>::at(const Key &key) {
+  Node *node = find_node_(key);
+  if (node == nullptr) {
+    throw std::out_of_range("Key not found");
+  }
+  return value_traits::mapped(node->data_);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::mapped_type &
+Tree<K, V, Comp, Alloc, Stats>::operator[](const key_type &key) {
+  return try_emplace_(key).first->second;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::mapped_type &
+Tree<K, V, Comp, Alloc, Stats>::operator[](key_type &&key) {
+  return try_emplace_(std::move(key)).first->second;
+}
+
+// Узлы other перевешиваются в это дерево без выделений и копирования.
+// Если аллокаторы не удалось объединить, значение переносится в новый узел.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::merge(
+    Tree<K, V, Comp, Alloc, Stats> &other) {
+  if (other.empty() || this == &other) return;
+  if (this->empty()) {
+    swap(other);
+    return;
+  }
+
+  bool adopted = false;
+  bool relink = share_allocator_(other, adopted);
+  try {
+    if (relink && other.size_ * kLinearMergeRatio >= size_) {
+      merge_linear_(other);
     } else {
-      cur->parent_->right_ = min;
+      NodeBase *cur = other.header_.left_;
+      while (cur != &other.header_) {
+        NodeBase *next = next_(cur);
+        bool to_left;
+        std::pair<NodeBase *, bool> pos =
+            find_insert_pos_(as_node_(cur)->key(), to_left);
+        if (pos.second) {
+          Node *node = as_node_(cur);
+          if (!relink) node = create_node_(std::move(node->data_));
+          other.unlink_node_(cur);
+          if (!relink) other.destroy_node_(as_node_(cur));
+          link_node_(node, pos.first, to_left);
+        }
+        cur = next;
+      }
     }
-    if (root_ == cur) {
-      root_ = min;
+  } catch (...) {
+    if (adopted) unshare_allocator_(other, fresh_allocator_());
+    throw;
+  }
+  if (adopted) unshare_allocator_(other, fresh_allocator_());
+}
+
+// Оба дерева обходятся по порядку, узлы раскладываются в два упорядоченных
+// массива и из каждого собирается сбалансированное дерево. Равные ключи
+// мультимножества из other встают после ключей этого дерева.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::merge_linear_(Tree &other) {
+  Vector<Node *> merged;
+  Vector<Node *> kept;
+  merged.reserve(size_ + other.size_);
+  NodeBase *x = header_.left_;
+  NodeBase *y = other.header_.left_;
+  while (y != &other.header_) {
+    int order = -1;
+    if (x != &header_) {
+      order = compare_(as_node_(y)->key(), as_node_(x)->key());
     }
-    delete cur;
-    size_--;
-  } else {
-    // один из детей есть
-    Node *tmp;
-    if (cur->left_ != nullptr) {
-      tmp = cur->left_;
+    if (order >= 0) {
+      if (!is_multi_set && order == 0) {
+        kept.push_back(as_node_(y));
+        y = next_(y);
+      }
+      merged.push_back(as_node_(x));
+      x = next_(x);
     } else {
-      tmp = cur->right_;
+      merged.push_back(as_node_(y));
+      y = next_(y);
     }
-    if (cur->parent_ && cur->parent_->left_ == cur) {
-      cur->parent_->left_ = tmp;
+  }
+  for (; x != &header_; x = next_(x)) merged.push_back(as_node_(x));
+  reset_header_();
+  link_sorted_(merged);
+  other.reset_header_();
+  other.size_ = 0;
+  other.link_sorted_(kept);
+}
+
+// Узлы можно перевешивать между деревьями, только если их аллокаторы равны.
+// Арена SlabAllocator, которой владеет только other, сливается с нашей
+// (adopted), и до unshare_allocator_ оба дерева выделяют из нее.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+bool Tree<K, V, Comp, Alloc, Stats>::share_allocator_(Tree &other,
+                                                      bool &adopted) noexcept {
+  adopted = false;
+  if (alloc_ == other.alloc_) return true;
+  if constexpr (std::is_same_v<node_allocator_type, SlabAllocator<Node>>) {
+    if (other.alloc_.can_release()) {
+      alloc_.adopt(other.alloc_);
+      other.alloc_ = alloc_;
+      adopted = true;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Арена не потокобезопасна, поэтому other не остается в нашей: его узлы
+// переносятся в узлы аллокатора own. Если памяти не хватило, other
+// продолжает делить арену с этим деревом.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::unshare_allocator_(
+    Tree &other, node_allocator_type own) noexcept {
+  Vector<Node *> nodes;
+  size_type built = 0;
+  try {
+    nodes.reserve(other.size_);
+    while (nodes.size() < other.size_) {
+      nodes.push_back(node_traits::allocate(own, 1));
     }
-    if (cur->parent_ && cur->parent_->right_ == cur) {
-      cur->parent_->right_ = tmp;
+    for (NodeBase *x = other.header_.left_; x != &other.header_;
+         x = next_(x)) {
+      node_traits::construct(own, nodes[built],
+                             std::move_if_noexcept(as_node_(x)->data_));
+      ++built;
     }
-    tmp->parent_ = cur->parent_;
-    if (root_ == cur) {
-      root_ = tmp;
+  } catch (...) {
+    for (size_type i = 0; i < nodes.size(); ++i) {
+      if (i < built) node_traits::destroy(own, nodes[i]);
+      node_traits::deallocate(own, nodes[i], 1);
     }
-    delete cur;
-    size_--;
+    return;
   }
+  destroy_subtree_(other.root_(), alloc_);
+  other.alloc_ = std::move(own);
+  other.reset_header_();
+  other.size_ = 0;
+  other.link_sorted_(nodes);
 }
 
-template <typename K, typename V>
-bool Tree<K, V>::empty() const noexcept {
-  return !root_;
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::node_allocator_type
+Tree<K, V, Comp, Alloc, Stats>::fresh_allocator_() const {
+  return node_traits::select_on_container_copy_construction(alloc_);
 }
 
-template <typename K, typename V>
-typename Tree<K, V>::size_type Tree<K, V>::max_size() const noexcept {
-  return std::numeric_limits<size_type>::max() / sizeof(Tree<V, V>) / 6;
+// Узел из handle с равным аллокатором встраивается как есть; иначе его
+// значение переносится в новый узел, а старый освобождает handle.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::insert_return_type
+Tree<K, V, Comp, Alloc, Stats>::insert_node_(node_type &&handle) {
+  if (handle.empty()) return {end(), false, node_type()};
+  bool to_left;
+  std::pair<NodeBase *, bool> pos =
+      find_insert_pos_(handle.node_->key(), to_left);
+  if (!pos.second) {
+    return {iterator(pos.first, *this), false, std::move(handle)};
+  }
+  Node *node = handle.node_;
+  if (*handle.alloc_ == alloc_) {
+    handle.node_ = nullptr;
+    handle.alloc_.reset();
+  } else {
+    node = create_node_(std::move(node->data_));
+    handle.reset_();
+  }
+  return {iterator(link_node_(node, pos.first, to_left), *this), true,
+          node_type()};
 }
 
-template <typename K, typename V>
-inline V &Tree<K, V>::at(const key_type &key) {
-  for (iterator it = this->begin(); it != this->end(); it++) {
-    if (it->first == key) {
-      return it->second;
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+Tree<K, V, Comp, Alloc, Stats>::NodeHandle::NodeHandle(
+    NodeHandle &&other) noexcept
+    : node_(other.node_), alloc_(std::move(other.alloc_)) {
+  other.node_ = nullptr;
+  other.alloc_.reset();
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::NodeHandle &
+Tree<K, V, Comp, Alloc, Stats>::NodeHandle::operator=(
+    NodeHandle &&other) noexcept {
+  if (this != &other) {
+    reset_();
+    node_ = other.node_;
+    alloc_ = std::move(other.alloc_);
+    other.node_ = nullptr;
+    other.alloc_.reset();
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::NodeHandle::reset_() noexcept {
+  if (node_ != nullptr) {
+    node_traits::destroy(*alloc_, node_);
+    node_traits::deallocate(*alloc_, node_, 1);
+    node_ = nullptr;
+  }
+  alloc_.reset();
+}
+
+// Один спуск от корня: равные ключи мультимножества уходят влево, а в
+// обычном дереве спуск останавливается на узле с тем же ключом.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+std::pair<typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *, bool>
+Tree<K, V, Comp, Alloc, Stats>::find_insert_pos_(const key_type &key,
+                                                 bool &to_left) const noexcept {
+  NodeBase *parent = const_cast<NodeBase *>(&header_);
+  NodeBase *cur = root_();
+  to_left = true;
+  while (cur != nullptr) {
+    const key_type &cur_key = as_node_(cur)->key();
+    if (is_multi_set) {
+      to_left = !comp_(cur_key, key);
+    } else {
+      int order = compare_(key, cur_key);
+      if (order == 0) return {cur, false};
+      to_left = order < 0;
     }
+    parent = cur;
+    cur = to_left ? cur->left_ : cur->right_;
   }
-  throw std::out_of_range("Key not found");
+  return {parent, true};
 }
 
-template <typename K, typename V>
-inline V &Tree<K, V>::operator[](const key_type &key) {
-  if (!contains(key)) {
-    push_(key, V());
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::Node *
+Tree<K, V, Comp, Alloc, Stats>::link_node_(Node *node, NodeBase *parent,
+                                           bool to_left) noexcept {
+  node->parent_ = parent;
+  if (parent == &header_) {
+    header_.parent_ = node;
+    header_.left_ = node;
+    header_.right_ = node;
+  } else if (to_left) {
+    parent->left_ = node;
+    if (parent == header_.left_) header_.left_ = node;
+  } else {
+    parent->right_ = node;
+    if (parent == header_.right_) header_.right_ = node;
+  }
+  if constexpr (Stats::kEnabled) {
+    node->count_ = 1;
+    for (; parent != &header_; parent = parent->parent_) ++parent->count_;
   }
-  return at(key);
+  insert_fixup_(node);
+  size_++;
+  return node;
 }
 
-template <typename K, typename V>
-void Tree<K, V>::merge(Tree<K, V> &other) {
-  if (other.root_ == nullptr || this->root_ == other.root_) return;
-  if (this->root_ == nullptr) swap(other);
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+std::pair<typename Tree<K, V, Comp, Alloc, Stats>::Iterator, bool>
+Tree<K, V, Comp, Alloc, Stats>::insert_value_(const value_type &value) {
+  bool to_left;
+  std::pair<NodeBase *, bool> pos =
+      find_insert_pos_(value_traits::key(value), to_left);
+  if (pos.second) {
+    pos.first = link_node_(create_node_(value), pos.first, to_left);
+  }
+  return {iterator(pos.first, *this), pos.second};
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+std::pair<typename Tree<K, V, Comp, Alloc, Stats>::Iterator, bool>
+Tree<K, V, Comp, Alloc, Stats>::insert_value_(
+    std::remove_const_t<value_type> &&value) {
+  bool to_left;
+  std::pair<NodeBase *, bool> pos =
+      find_insert_pos_(value_traits::key(value), to_left);
+  if (pos.second) {
+    pos.first = link_node_(create_node_(std::move(value)), pos.first, to_left);
+  }
+  return {iterator(pos.first, *this), pos.second};
+}
+
+// Ключ становится известен только после создания значения, поэтому узел
+// строится заранее и уничтожается, если такой ключ уже есть.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename... Args>
+std::pair<typename Tree<K, V, Comp, Alloc, Stats>::Iterator, bool>
+Tree<K, V, Comp, Alloc, Stats>::emplace_(Args &&...args) {
+  Node *node = create_node_(std::forward<Args>(args)...);
+  bool to_left;
+  std::pair<NodeBase *, bool> pos = find_insert_pos_(node->key(), to_left);
+  if (!pos.second) {
+    destroy_node_(node);
+    return {iterator(pos.first, *this), false};
+  }
+  return {iterator(link_node_(node, pos.first, to_left), *this), true};
+}
+
+// Значение строится на месте в узле и только если ключа еще нет.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key, typename... Args>
+std::pair<typename Tree<K, V, Comp, Alloc, Stats>::Iterator, bool>
+Tree<K, V, Comp, Alloc, Stats>::try_emplace_(Key &&key, Args &&...args) {
+  bool to_left;
+  std::pair<NodeBase *, bool> pos = find_insert_pos_(key, to_left);
+  if (!pos.second) {
+    return {iterator(pos.first, *this), false};
+  }
+  Node *node = create_node_(
+      std::piecewise_construct, std::forward_as_tuple(std::forward<Key>(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+  return {iterator(link_node_(node, pos.first, to_left), *this), true};
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::Node *
+Tree<K, V, Comp, Alloc, Stats>::as_node_(NodeBase *node) noexcept {
+  return static_cast<Node *>(node);
+}
 
-  iterator it = other.begin();
-  iterator it_erase = other.begin();
-  while (it != other.end()) {
-    ++it;
-    if (!contains(it_erase->first) || is_multi_set) {
-      push_(it_erase->first, it_erase->second);
-      other.erase(it_erase);
+// Следующий по порядку узел; для максимума возвращает заголовок.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *
+Tree<K, V, Comp, Alloc, Stats>::next_(NodeBase *node) noexcept {
+  if (node->parent_ == nullptr) {
+    return node;
+  }
+  if (node->right_ != nullptr) {
+    node = node->right_;
+    while (node->left_ != nullptr) {
+      node = node->left_;
+    }
+  } else {
+    NodeBase *parent = node->parent_;
+    while (node == parent->right_) {
+      node = parent;
+      parent = parent->parent_;
     }
-    it_erase = it;
+    // корень без правого поддерева: node уже стоит на заголовке
+    if (node->right_ != parent) node = parent;
   }
+  return node;
 }
 
-template <typename K, typename V>
-void Tree<K, V>::insert_(Node *&node_, K key, V value) {
-  if (key <= node_->data_.first) {
-    if (node_->left_ == nullptr) {
-      node_->left_ = new Node({key, value});
-      node_->left_->parent_ = node_;
-    } else {
-      insert_(node_->left_, key, value);
+// Предыдущий по порядку узел; для заголовка возвращает максимум.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *
+Tree<K, V, Comp, Alloc, Stats>::prev_(NodeBase *node) noexcept {
+  if (node->parent_ == nullptr) {
+    // заголовок пустого дерева: у настоящих узлов родитель есть всегда
+    return node;
+  }
+  if (node->color_ == kRed && node->parent_->parent_ == node) {
+    // заголовок красный, а корень всегда черный
+    node = node->right_;
+  } else if (node->left_ != nullptr) {
+    node = node->left_;
+    while (node->right_ != nullptr) {
+      node = node->right_;
     }
-  } else if (key > node_->data_.first) {
-    if (node_->right_ == nullptr) {
-      node_->right_ = new Node({key, value});
-      node_->right_->parent_ = node_;
-    } else {
-      insert_(node_->right_, key, value);
+  } else {
+    NodeBase *parent = node->parent_;
+    while (node == parent->left_) {
+      node = parent;
+      parent = parent->parent_;
     }
+    node = parent;
   }
+  return node;
 }
 
-template <typename K, typename V>
-void Tree<K, V>::push_(K key, V value) {
-  if (!empty() && (contains(key) && !is_multi_set)) {
-    return;
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *
+Tree<K, V, Comp, Alloc, Stats>::root_() const noexcept {
+  return header_.parent_;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline void Tree<K, V, Comp, Alloc, Stats>::reset_header_() noexcept {
+  header_.parent_ = nullptr;
+  header_.left_ = &header_;
+  header_.right_ = &header_;
+  header_.color_ = kRed;
+}
+
+// После обмена заголовками корень должен снова ссылаться на свой заголовок.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline void Tree<K, V, Comp, Alloc, Stats>::fix_header_() noexcept {
+  if (header_.parent_ != nullptr) {
+    header_.parent_->parent_ = &header_;
+  } else {
+    reset_header_();
+  }
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline bool Tree<K, V, Comp, Alloc, Stats>::is_red_(
+    const NodeBase *node) noexcept {
+  return node != nullptr && node->color_ == kRed;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::size_type
+Tree<K, V, Comp, Alloc, Stats>::subtree_size_(const NodeBase *node) noexcept {
+  if constexpr (Stats::kEnabled) {
+    return node != nullptr ? node->count_ : 0;
+  } else {
+    static_cast<void>(node);
+    return 0;
   }
-  if (this->root_ == nullptr) {
-    this->root_ = new Node({key, value});
+}
+
+// Пересчитывает размер узла по детям; без OrderStatistics ничего не делает.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline void Tree<K, V, Comp, Alloc, Stats>::update_size_(
+    NodeBase *node) noexcept {
+  if constexpr (Stats::kEnabled) {
+    node->count_ = 1 + subtree_size_(node->left_) + subtree_size_(node->right_);
   } else {
-    insert_(this->root_, key, value);
+    static_cast<void>(node);
   }
-  this->size_++;
 }
 
-template <typename K, typename V>
-inline bool Tree<K, V>::contains(const key_type &key) const noexcept {
-  for (iterator it = this->begin(); it != this->end(); ++it) {
-    if (it->first == key) {
-      return true;
+// Число элементов левее node; для заголовка (end()) это size().
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::size_type
+Tree<K, V, Comp, Alloc, Stats>::index_of_(const NodeBase *node) const noexcept {
+  if (node == &header_) return size_;
+  size_type index = subtree_size_(node->left_);
+  for (; node->parent_ != &header_; node = node->parent_) {
+    if (node == node->parent_->right_) {
+      index += subtree_size_(node->parent_->left_) + 1;
     }
   }
-  return false;
+  return index;
 }
 
-template <typename K, typename V>
-void Tree<K, V>::clear_node(Node *node) {
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::rotate_left_(NodeBase *node) noexcept {
+  NodeBase *pivot = node->right_;
+  node->right_ = pivot->left_;
+  if (pivot->left_ != nullptr) {
+    pivot->left_->parent_ = node;
+  }
+  transplant_(node, pivot);
+  pivot->left_ = node;
+  node->parent_ = pivot;
+  update_size_(node);
+  update_size_(pivot);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::rotate_right_(NodeBase *node) noexcept {
+  NodeBase *pivot = node->left_;
+  node->left_ = pivot->right_;
+  if (pivot->right_ != nullptr) {
+    pivot->right_->parent_ = node;
+  }
+  transplant_(node, pivot);
+  pivot->right_ = node;
+  node->parent_ = pivot;
+  update_size_(node);
+  update_size_(pivot);
+}
+
+// Ставит child (возможно nullptr) на место node у родителя node.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::transplant_(NodeBase *node,
+                                                 NodeBase *child) noexcept {
+  if (node == root_()) {
+    header_.parent_ = child;
+  } else if (node == node->parent_->left_) {
+    node->parent_->left_ = child;
+  } else {
+    node->parent_->right_ = child;
+  }
+  if (child != nullptr) {
+    child->parent_ = node->parent_;
+  }
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::insert_fixup_(NodeBase *node) noexcept {
+  while (node != root_() && is_red_(node->parent_)) {
+    NodeBase *parent = node->parent_;
+    NodeBase *grand = parent->parent_;
+    if (parent == grand->left_) {
+      NodeBase *uncle = grand->right_;
+      if (is_red_(uncle)) {
+        parent->color_ = kBlack;
+        uncle->color_ = kBlack;
+        grand->color_ = kRed;
+        node = grand;
+      } else {
+        if (node == parent->right_) {
+          node = parent;
+          rotate_left_(node);
+          parent = node->parent_;
+        }
+        parent->color_ = kBlack;
+        grand->color_ = kRed;
+        rotate_right_(grand);
+      }
+    } else {
+      NodeBase *uncle = grand->left_;
+      if (is_red_(uncle)) {
+        parent->color_ = kBlack;
+        uncle->color_ = kBlack;
+        grand->color_ = kRed;
+        node = grand;
+      } else {
+        if (node == parent->left_) {
+          node = parent;
+          rotate_right_(node);
+          parent = node->parent_;
+        }
+        parent->color_ = kBlack;
+        grand->color_ = kRed;
+        rotate_left_(grand);
+      }
+    }
+  }
+  root_()->color_ = kBlack;
+}
+
+// node занял место удаленного черного узла и несет лишнюю "черноту";
+// parent передается отдельно, так как node может быть nullptr.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::erase_fixup_(
+    NodeBase *node, NodeBase *parent) noexcept {
+  while (node != root_() && !is_red_(node)) {
+    if (node == parent->left_) {
+      NodeBase *sibling = parent->right_;
+      if (is_red_(sibling)) {
+        sibling->color_ = kBlack;
+        parent->color_ = kRed;
+        rotate_left_(parent);
+        sibling = parent->right_;
+      }
+      if (!is_red_(sibling->left_) && !is_red_(sibling->right_)) {
+        sibling->color_ = kRed;
+        node = parent;
+        parent = node->parent_;
+      } else {
+        if (!is_red_(sibling->right_)) {
+          sibling->left_->color_ = kBlack;
+          sibling->color_ = kRed;
+          rotate_right_(sibling);
+          sibling = parent->right_;
+        }
+        sibling->color_ = parent->color_;
+        parent->color_ = kBlack;
+        sibling->right_->color_ = kBlack;
+        rotate_left_(parent);
+        node = root_();
+      }
+    } else {
+      NodeBase *sibling = parent->left_;
+      if (is_red_(sibling)) {
+        sibling->color_ = kBlack;
+        parent->color_ = kRed;
+        rotate_right_(parent);
+        sibling = parent->left_;
+      }
+      if (!is_red_(sibling->left_) && !is_red_(sibling->right_)) {
+        sibling->color_ = kRed;
+        node = parent;
+        parent = node->parent_;
+      } else {
+        if (!is_red_(sibling->left_)) {
+          sibling->right_->color_ = kBlack;
+          sibling->color_ = kRed;
+          rotate_left_(sibling);
+          sibling = parent->left_;
+        }
+        sibling->color_ = parent->color_;
+        parent->color_ = kBlack;
+        sibling->left_->color_ = kBlack;
+        rotate_right_(parent);
+        node = root_();
+      }
+    }
+  }
+  if (node != nullptr) {
+    node->color_ = kBlack;
+  }
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline bool Tree<K, V, Comp, Alloc, Stats>::contains(
+    const key_type &key) const noexcept {
+  return find_node_(key) != nullptr;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key, typename>
+inline bool Tree<K, V, Comp, Alloc, Stats>::contains(
+    const Key &key) const noexcept {
+  return find_node_(key) != nullptr;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::clear_node(NodeBase *node) {
   if (node->left_ != nullptr) {
     clear_node(node->left_);
   }
   if (node->right_ != nullptr) {
     clear_node(node->right_);
   }
-  delete node;
+  destroy_node_(as_node_(node));
 }
 
-template <typename K, typename V>
-inline typename Tree<K, V>::Iterator Tree<K, V>::find_pos_(
-    const key_type &key) noexcept {
-  for (iterator it = this->begin(); it != this->end(); ++it) {
-    if (it->first == key) {
-      return it;
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename... Args>
+typename Tree<K, V, Comp, Alloc, Stats>::Node *
+Tree<K, V, Comp, Alloc, Stats>::create_node_(Args &&...args) {
+  Node *node = node_traits::allocate(alloc_, 1);
+  try {
+    node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+  } catch (...) {
+    node_traits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  return node;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::destroy_node_(Node *node) noexcept {
+  node_traits::destroy(alloc_, node);
+  node_traits::deallocate(alloc_, node, 1);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::destroy_values_(NodeBase *node) noexcept {
+  if constexpr (!std::is_trivially_destructible_v<value_type>) {
+    if (node->left_ != nullptr) {
+      destroy_values_(node->left_);
     }
+    if (node->right_ != nullptr) {
+      destroy_values_(node->right_);
+    }
+    node_traits::destroy(alloc_, as_node_(node));
   }
-  return end();
 }
 
-template <typename K, typename V>
-inline typename Tree<K, V>::iterator Tree<K, V>::begin() const {
-  if (this->root_ == nullptr) {
-    return iterator(nullptr, *this);
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key>
+inline typename Tree<K, V, Comp, Alloc, Stats>::Iterator
+Tree<K, V, Comp, Alloc, Stats>::find_pos_(const Key &key) noexcept {
+  Node *node = find_node_(key);
+  return node ? iterator(node, *this) : end();
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key>
+inline typename Tree<K, V, Comp, Alloc, Stats>::Node *
+Tree<K, V, Comp, Alloc, Stats>::find_node_(const Key &key) const noexcept {
+  NodeBase *node = lower_bound_node_(key);
+  if (node == &header_ || comp_(key, as_node_(node)->key())) {
+    return nullptr;
+  }
+  return as_node_(node);
+}
+
+// Спуск от корня к листу: равные ключи лежат в левом поддереве, поэтому
+// запоминаем последний узел не меньше key - это самый левый дубликат.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key>
+inline typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *
+Tree<K, V, Comp, Alloc, Stats>::lower_bound_node_(
+    const Key &key) const noexcept {
+  NodeBase *node = root_();
+  NodeBase *candidate = const_cast<NodeBase *>(&header_);
+  while (node != nullptr) {
+    if (comp_(as_node_(node)->key(), key)) {
+      node = node->right_;
+    } else {
+      candidate = node;
+      node = node->left_;
+    }
   }
-  Node *tmp_node = root_;
-  while (tmp_node->left_ != nullptr) {
-    tmp_node = tmp_node->left_;
+  return candidate;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key>
+inline typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *
+Tree<K, V, Comp, Alloc, Stats>::upper_bound_node_(
+    const Key &key) const noexcept {
+  NodeBase *node = root_();
+  NodeBase *candidate = const_cast<NodeBase *>(&header_);
+  while (node != nullptr) {
+    if (comp_(key, as_node_(node)->key())) {
+      candidate = node;
+      node = node->left_;
+    } else {
+      node = node->right_;
+    }
   }
-  iterator tmp(tmp_node, *this);
-  return tmp;
+  return candidate;
 }
 
-template <typename K, typename V>
-inline typename Tree<K, V>::iterator Tree<K, V>::end() const {
-  return Iterator(nullptr, *this);
+// Знак результата как у a - b. Строковый ключ сравнивается за один проход,
+// иначе компаратор вызывается до двух раз.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename A, typename B>
+inline int Tree<K, V, Comp, Alloc, Stats>::compare_(
+    const A &a, const B &b) const {
+  if constexpr (StringCompare<Comp, K>::value) {
+    using view_type = typename StringCompare<Comp, K>::view_type;
+    if constexpr (std::is_convertible_v<const A &, view_type> &&
+                  std::is_convertible_v<const B &, view_type>) {
+      return view_type(a).compare(view_type(b));
+    }
+  }
+  if (comp_(a, b)) return -1;
+  return comp_(b, a) ? 1 : 0;
 }
 
-template <typename K, typename V>
-inline typename Tree<K, V>::Iterator Tree<K, V>::Iterator::operator++() {
-  increase_();
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::iterator
+Tree<K, V, Comp, Alloc, Stats>::lower_bound(const key_type &key) const {
+  return iterator(lower_bound_node_(key), *this);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key, typename>
+inline typename Tree<K, V, Comp, Alloc, Stats>::iterator
+Tree<K, V, Comp, Alloc, Stats>::lower_bound(const Key &key) const {
+  return iterator(lower_bound_node_(key), *this);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::iterator
+Tree<K, V, Comp, Alloc, Stats>::upper_bound(const key_type &key) const {
+  return iterator(upper_bound_node_(key), *this);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key, typename>
+inline typename Tree<K, V, Comp, Alloc, Stats>::iterator
+Tree<K, V, Comp, Alloc, Stats>::upper_bound(const Key &key) const {
+  return iterator(upper_bound_node_(key), *this);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline std::pair<typename Tree<K, V, Comp, Alloc, Stats>::iterator,
+                 typename Tree<K, V, Comp, Alloc, Stats>::iterator>
+Tree<K, V, Comp, Alloc, Stats>::equal_range(const key_type &key) const {
+  return equal_range_(key);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key, typename>
+inline std::pair<typename Tree<K, V, Comp, Alloc, Stats>::iterator,
+                 typename Tree<K, V, Comp, Alloc, Stats>::iterator>
+Tree<K, V, Comp, Alloc, Stats>::equal_range(const Key &key) const {
+  return equal_range_(key);
+}
+
+// Без дубликатов верхняя граница - следующий за найденным узел, второй
+// спуск нужен только мультимножеству.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key>
+std::pair<typename Tree<K, V, Comp, Alloc, Stats>::iterator,
+          typename Tree<K, V, Comp, Alloc, Stats>::iterator>
+Tree<K, V, Comp, Alloc, Stats>::equal_range_(const Key &key) const {
+  NodeBase *first = lower_bound_node_(key);
+  NodeBase *last = first;
+  if (first != &header_ && !comp_(key, as_node_(first)->key())) {
+    last = is_multi_set ? upper_bound_node_(key) : next_(first);
+  }
+  return {iterator(first, *this), iterator(last, *this)};
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::size_type
+Tree<K, V, Comp, Alloc, Stats>::count(const key_type &key) const {
+  return count_equal_(key);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key, typename>
+inline typename Tree<K, V, Comp, Alloc, Stats>::size_type
+Tree<K, V, Comp, Alloc, Stats>::count(const Key &key) const {
+  return count_equal_(key);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key>
+typename Tree<K, V, Comp, Alloc, Stats>::size_type
+Tree<K, V, Comp, Alloc, Stats>::count_equal_(const Key &key) const {
+  if constexpr (Stats::kEnabled) {
+    if (is_multi_set) {
+      return index_of_(upper_bound_node_(key)) -
+             index_of_(lower_bound_node_(key));
+    }
+  }
+  size_type count = 0;
+  NodeBase *node = lower_bound_node_(key);
+  while (node != &header_ && !comp_(key, as_node_(node)->key())) {
+    ++count;
+    if (!is_multi_set) break;
+    node = next_(node);
+  }
+  return count;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::size_type
+Tree<K, V, Comp, Alloc, Stats>::rank(const key_type &key) const {
+  static_assert(Stats::kEnabled, "rank needs the OrderStatistics policy");
+  return index_of_(lower_bound_node_(key));
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Key, typename>
+typename Tree<K, V, Comp, Alloc, Stats>::size_type
+Tree<K, V, Comp, Alloc, Stats>::rank(const Key &key) const {
+  static_assert(Stats::kEnabled, "rank needs the OrderStatistics policy");
+  return index_of_(lower_bound_node_(key));
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::iterator
+Tree<K, V, Comp, Alloc, Stats>::select(size_type k) const {
+  static_assert(Stats::kEnabled, "select needs the OrderStatistics policy");
+  if (k >= size_) return end();
+  NodeBase *node = root_();
+  while (k != subtree_size_(node->left_)) {
+    if (k < subtree_size_(node->left_)) {
+      node = node->left_;
+    } else {
+      k -= subtree_size_(node->left_) + 1;
+      node = node->right_;
+    }
+  }
+  return iterator(node, *this);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::iterator
+Tree<K, V, Comp, Alloc, Stats>::nth(size_type k) const {
+  return select(k);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::iterator
+Tree<K, V, Comp, Alloc, Stats>::begin() const {
+  return iterator(header_.left_, *this);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::iterator
+Tree<K, V, Comp, Alloc, Stats>::end() const {
+  return Iterator(const_cast<NodeBase *>(&header_), *this);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::Iterator
+Tree<K, V, Comp, Alloc, Stats>::Iterator::operator++() {
+  current_ = next_(current_);
   return *this;
 }
 
-template <typename K, typename V>
-inline typename Tree<K, V>::Iterator Tree<K, V>::Iterator::operator++(int) {
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::Iterator
+Tree<K, V, Comp, Alloc, Stats>::Iterator::operator++(int) {
   Iterator tmp(*this);
-  increase_();
+  current_ = next_(current_);
   return tmp;
 }
 
-template <typename K, typename V>
-inline typename Tree<K, V>::Iterator Tree<K, V>::Iterator::operator--() {
-  decrease_();
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::Iterator
+Tree<K, V, Comp, Alloc, Stats>::Iterator::operator--() {
+  current_ = prev_(current_);
   return *this;
 }
 
-template <typename K, typename V>
-inline typename Tree<K, V>::Iterator Tree<K, V>::Iterator::operator--(int) {
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+inline typename Tree<K, V, Comp, Alloc, Stats>::Iterator
+Tree<K, V, Comp, Alloc, Stats>::Iterator::operator--(int) {
   Iterator tmp(*this);
-  decrease_();
+  current_ = prev_(current_);
   return tmp;
 }
 
-template <typename K, typename V>
-inline void Tree<K, V>::Iterator::increase_() {
-  if (current_ == nullptr) {
-    current_ = find_parent_(tree_->begin().Get());
-    current_ = find_rightmost_(current_);
-  } else if (current_ == max_()) {
-    current_ = nullptr;
-  } else {
-    if (current_->right_ != nullptr) {
-      current_ = current_->right_;
-      current_ = find_leftmost_(current_);
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::Iterator
+Tree<K, V, Comp, Alloc, Stats>::Iterator::operator+(difference_type n) const {
+  static_assert(Stats::kEnabled, "iterator arithmetic needs OrderStatistics");
+  difference_type index =
+      static_cast<difference_type>(tree_->index_of_(current_)) + n;
+  return tree_->select(static_cast<size_type>(index));
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::Iterator
+Tree<K, V, Comp, Alloc, Stats>::Iterator::operator-(difference_type n) const {
+  return *this + (-n);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::Iterator &
+Tree<K, V, Comp, Alloc, Stats>::Iterator::operator+=(difference_type n) {
+  current_ = (*this + n).current_;
+  return *this;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::Iterator &
+Tree<K, V, Comp, Alloc, Stats>::Iterator::operator-=(difference_type n) {
+  current_ = (*this + (-n)).current_;
+  return *this;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::difference_type
+Tree<K, V, Comp, Alloc, Stats>::Iterator::operator-(
+    const Iterator &other) const {
+  static_assert(Stats::kEnabled, "iterator arithmetic needs OrderStatistics");
+  return static_cast<difference_type>(tree_->index_of_(current_)) -
+         static_cast<difference_type>(tree_->index_of_(other.current_));
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::assign_clone_(const Tree &other) {
+  if constexpr (kParallelClone) {
+    int depth = fork_depth_(std::thread::hardware_concurrency());
+    if (other.size_ >= kParallelCloneSize && depth > 0) {
+      clear();
+      attach_root_(clone_parallel_(other.root_(), alloc_, depth),
+                   other.size_);
+      return;
+    }
+  }
+  NodeBase *pool = nullptr;
+  if (root_() != nullptr) detach_(root_(), pool);
+  reset_header_();
+  size_ = 0;
+  try {
+    if (other.root_() != nullptr) {
+      attach_root_(clone_(other.root_(), &header_, pool), other.size_);
+    }
+  } catch (...) {
+    destroy_subtree_(pool, alloc_);
+    throw;
+  }
+  destroy_subtree_(pool, alloc_);
+}
+
+// Складывает узлы поддерева в пул, связанный через left_.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::detach_(NodeBase *node,
+                                             NodeBase *&pool) noexcept {
+  if (node->left_ != nullptr) detach_(node->left_, pool);
+  if (node->right_ != nullptr) detach_(node->right_, pool);
+  node->left_ = pool;
+  node->right_ = nullptr;
+  pool = node;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::Node *
+Tree<K, V, Comp, Alloc, Stats>::reuse_node_(NodeBase *&pool,
+                                            const value_type &elem) {
+  if (pool == nullptr) return create_node_(elem);
+  Node *node = as_node_(pool);
+  pool = pool->left_;
+  node_traits::destroy(alloc_, node);
+  try {
+    node_traits::construct(alloc_, node, elem);
+  } catch (...) {
+    node_traits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  return node;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *
+Tree<K, V, Comp, Alloc, Stats>::clone_(const NodeBase *src, NodeBase *parent,
+                                       NodeBase *&pool) {
+  Node *node = reuse_node_(pool, static_cast<const Node *>(src)->data_);
+  node->color_ = src->color_;
+  node->parent_ = parent;
+  node->left_ = nullptr;
+  node->right_ = nullptr;
+  try {
+    if (src->left_ != nullptr) node->left_ = clone_(src->left_, node, pool);
+    if (src->right_ != nullptr) node->right_ = clone_(src->right_, node, pool);
+  } catch (...) {
+    clear_node(node);
+    throw;
+  }
+  update_size_(node);
+  return node;
+}
+
+// Правое поддерево копируется в отдельном потоке со своим аллокатором;
+// для SlabAllocator его арена затем присоединяется к арене alloc.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *
+Tree<K, V, Comp, Alloc, Stats>::clone_parallel_(const NodeBase *src,
+                                                node_allocator_type &alloc,
+                                                int depth) {
+  if (src == nullptr) return nullptr;
+  Node *node = node_traits::allocate(alloc, 1);
+  try {
+    node_traits::construct(alloc, node, static_cast<const Node *>(src)->data_);
+  } catch (...) {
+    node_traits::deallocate(alloc, node, 1);
+    throw;
+  }
+  node->color_ = src->color_;
+  node->left_ = nullptr;
+  node->right_ = nullptr;
+  NodeBase *left = nullptr;
+  NodeBase *right = nullptr;
+  try {
+    if (depth > 0 && src->right_ != nullptr) {
+      node_allocator_type right_alloc;
+      std::future<NodeBase *> task;
+      try {
+        task = std::async(std::launch::async, [&right_alloc, src, depth]() {
+          return clone_parallel_(src->right_, right_alloc, depth - 1);
+        });
+      } catch (const std::system_error &) {
+        // поток не создан: правое поддерево копируется здесь же
+      }
+      try {
+        left = clone_parallel_(src->left_, alloc, depth - 1);
+      } catch (...) {
+        try {
+          if (task.valid()) destroy_subtree_(task.get(), right_alloc);
+        } catch (...) {
+        }
+        throw;
+      }
+      try {
+        right = task.valid() ? task.get()
+                             : clone_parallel_(src->right_, right_alloc, 0);
+      } catch (...) {
+        destroy_subtree_(left, alloc);
+        throw;
+      }
+      if constexpr (std::is_same_v<node_allocator_type, SlabAllocator<Node>>) {
+        alloc.adopt(right_alloc);
+      }
     } else {
-      while (current_->parent_ != nullptr &&
-             current_->data_.first > current_->parent_->data_.first) {
-        current_ = current_->parent_;
+      left = clone_parallel_(src->left_, alloc, 0);
+      try {
+        right = clone_parallel_(src->right_, alloc, 0);
+      } catch (...) {
+        destroy_subtree_(left, alloc);
+        throw;
       }
-      if (current_->parent_ != nullptr) current_ = current_->parent_;
     }
+  } catch (...) {
+    node_traits::destroy(alloc, node);
+    node_traits::deallocate(alloc, node, 1);
+    throw;
   }
+  set_children_(node, left, right);
+  return node;
 }
 
-template <typename K, typename V>
-inline void Tree<K, V>::Iterator::decrease_() {
-  if (current_ == nullptr) {
-    current_ = find_parent_(tree_->begin().Get());
-    current_ = find_rightmost_(current_);
-  } else if (current_ == min_()) {
-    current_ = nullptr;
+// Освобождает поддерево; для пула из detach_ обходит цепочку по left_.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::size_type
+Tree<K, V, Comp, Alloc, Stats>::destroy_subtree_(
+    NodeBase *node, node_allocator_type &alloc) noexcept {
+  size_type count = 0;
+  while (node != nullptr) {
+    count += destroy_subtree_(node->right_, alloc);
+    NodeBase *left = node->left_;
+    node_traits::destroy(alloc, as_node_(node));
+    node_traits::deallocate(alloc, as_node_(node), 1);
+    node = left;
+    ++count;
+  }
+  return count;
+}
+
+// Глубина ветвления, при которой задач не меньше, чем потоков.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+int Tree<K, V, Comp, Alloc, Stats>::fork_depth_(unsigned threads) noexcept {
+  int depth = 0;
+  while ((1u << depth) < threads) ++depth;
+  return depth;
+}
+
+// Подвешивает поддерево к заголовку; корень перекрашивается в черный.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::attach_root_(
+    NodeBase *root, size_type size) noexcept {
+  reset_header_();
+  size_ = size;
+  if (root == nullptr) return;
+  root->parent_ = &header_;
+  root->color_ = kBlack;
+  header_.parent_ = root;
+  header_.left_ = root;
+  while (header_.left_->left_ != nullptr) {
+    header_.left_ = header_.left_->left_;
+  }
+  header_.right_ = root;
+  while (header_.right_->right_ != nullptr) {
+    header_.right_ = header_.right_->right_;
+  }
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::node_type
+Tree<K, V, Comp, Alloc, Stats>::split(const key_type &key, Tree &right) {
+  right.clear();
+  right.comp_ = comp_;
+  // Правая половина остается в нашей арене до конца разбиения, а затем
+  // переносится в собственный аллокатор right.
+  bool shared = alloc_ == right.alloc_;
+  node_allocator_type own = std::move(right.alloc_);
+  right.alloc_ = alloc_;
+  size_type total = size_;
+  NodeBase *found = nullptr;
+  Subtree greater{nullptr, 0};
+  Subtree less = split_(detach_root_(), key, found, greater);
+  attach_root_(less.root_, subtree_size_(less.root_));
+  right.attach_root_(greater.root_, subtree_size_(greater.root_));
+  if constexpr (!Stats::kEnabled) {
+    // размер меньшей половины считается обходом обеих навстречу друг другу
+    size_type counted = 0;
+    NodeBase *x = header_.left_;
+    NodeBase *y = right.header_.right_;
+    while (x != &header_ && y != &right.header_) {
+      x = next_(x);
+      y = prev_(y);
+      ++counted;
+    }
+    size_type rest = total - counted - (found != nullptr ? 1 : 0);
+    size_ = x == &header_ ? counted : rest;
+    right.size_ = x == &header_ ? rest : counted;
+  }
+  if (found == nullptr && is_multi_set && !right.empty() &&
+      !comp_(key, as_node_(right.header_.left_)->key())) {
+    found = right.unlink_node_(right.header_.left_);
+  }
+  if (!shared) unshare_allocator_(right, std::move(own));
+  if (found == nullptr) return node_type();
+  found->parent_ = nullptr;
+  found->color_ = kRed;
+  update_size_(found);
+  return node_type(as_node_(found), alloc_);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::join(Tree &left, node_type &&pivot,
+                                          Tree &right) {
+  Tree lower(std::move(left));
+  Tree upper(std::move(right));
+  clear();
+  swap(lower);
+  bool adopted = false;
+  if (!share_allocator_(upper, adopted)) {
+    merge(upper);
+    if (!pivot.empty()) insert_node_(std::move(pivot));
+    return;
+  }
+  size_type size = size_ + upper.size_;
+  Subtree a = detach_root_();
+  Subtree b = upper.detach_root_();
+  Subtree joined;
+  if (pivot.empty()) {
+    joined = join2_(a, b);
   } else {
-    if (current_->left_ != nullptr) {
-      current_ = current_->left_;
-      current_ = find_rightmost_(current_);
+    Node *node = pivot.node_;
+    if (*pivot.alloc_ == alloc_) {
+      pivot.node_ = nullptr;
+      pivot.alloc_.reset();
     } else {
-      while (current_->parent_ != nullptr &&
-             current_->data_.first < current_->parent_->data_.first) {
-        current_ = current_->parent_;
+      try {
+        node = create_node_(std::move(node->data_));
+      } catch (...) {
+        attach_root_(join2_(a, b).root_, size);
+        throw;
       }
-      if (current_->parent_ != nullptr) current_ = current_->parent_;
+      pivot.reset_();
     }
+    joined = join_(a, node, b);
+    ++size;
   }
+  attach_root_(joined.root_, size);
 }
 
-template <typename K, typename V>
-inline typename Tree<K, V>::Node *Tree<K, V>::Iterator::find_parent_(
-    Node *node) {
-  if (node == nullptr) {
-    return nullptr;
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::union_with(Tree &other, unsigned threads) {
+  combine_with_(other, SetOperation::kUnion, threads);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::intersect_with(
+    Tree &other, unsigned threads) {
+  combine_with_(other, SetOperation::kIntersection, threads);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::difference_with(
+    Tree &other, unsigned threads) {
+  combine_with_(other, SetOperation::kDifference, threads);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::symmetric_difference_with(
+    Tree &other, unsigned threads) {
+  combine_with_(other, SetOperation::kSymmetricDifference, threads);
+}
+
+// Выброшенные узлы освобождаются уже после объединения потоков: арена
+// аллокатора не потокобезопасна.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::combine_with_(
+    Tree &other, SetOperation op, unsigned threads) {
+  if (this == &other) {
+    if (op == SetOperation::kDifference ||
+        op == SetOperation::kSymmetricDifference) {
+      clear();
+    }
+    return;
   }
-  while (node->parent_ != nullptr) {
-    node = node->parent_;
+  bool adopted = false;
+  if (is_multi_set || !share_allocator_(other, adopted)) {
+    assign_set_operation(*this, other, op);
+    other.clear();
+    return;
   }
-  return node;
+  if (threads == 0) threads = std::thread::hardware_concurrency();
+  int depth = threads > 1 ? fork_depth_(threads) + 2 : 0;
+  size_type size = size_ + other.size_;
+  Subtree a = detach_root_();
+  Subtree b = other.detach_root_();
+  if (adopted) unshare_allocator_(other, fresh_allocator_());
+  Garbage garbage;
+  Subtree result = combine_(a, b, op, garbage, depth);
+  size -= destroy_garbage_(garbage);
+  attach_root_(result.root_, size);
 }
 
-template <typename K, typename V>
-typename Tree<K, V>::Node *Tree<K, V>::Iterator::find_leftmost_(Node *node) {
-  while (node->left_ != nullptr) {
-    node = node->left_;
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::Garbage::push(NodeBase *node) noexcept {
+  if (node == nullptr) return;
+  node->parent_ = nullptr;
+  if (tail_ == nullptr) {
+    head_ = node;
+  } else {
+    tail_->parent_ = node;
   }
-  return node;
+  tail_ = node;
 }
 
-template <typename K, typename V>
-typename Tree<K, V>::Node *Tree<K, V>::Iterator::find_rightmost_(Node *node) {
-  if (node == nullptr) {
-    return nullptr;
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::Garbage::append(Garbage &other) noexcept {
+  if (other.head_ == nullptr) return;
+  if (tail_ == nullptr) {
+    head_ = other.head_;
+  } else {
+    tail_->parent_ = other.head_;
   }
-  while (node->right_ != nullptr) {
-    node = node->right_;
+  tail_ = other.tail_;
+  other.head_ = nullptr;
+  other.tail_ = nullptr;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::size_type
+Tree<K, V, Comp, Alloc, Stats>::destroy_garbage_(Garbage &garbage) noexcept {
+  size_type count = 0;
+  while (garbage.head_ != nullptr) {
+    NodeBase *next = garbage.head_->parent_;
+    count += destroy_subtree_(garbage.head_, alloc_);
+    garbage.head_ = next;
   }
-  return node;
+  garbage.tail_ = nullptr;
+  return count;
 }
 
-template <typename K, typename V>
-inline typename Tree<K, V>::Node *Tree<K, V>::Iterator::max_() {
-  Node *tmp_max = find_parent_(current_);
-  tmp_max = find_rightmost_(tmp_max);
-  return tmp_max;
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+int Tree<K, V, Comp, Alloc, Stats>::black_height_(
+    const NodeBase *root) noexcept {
+  int height = 0;
+  for (; root != nullptr; root = root->left_) {
+    if (root->color_ == kBlack) ++height;
+  }
+  return height;
 }
 
-template <typename K, typename V>
-inline typename Tree<K, V>::Node *Tree<K, V>::Iterator::min_() {
-  Node *tmp_min = find_parent_(current_);
-  tmp_min = find_leftmost_(tmp_min);
-  return tmp_min;
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::Subtree
+Tree<K, V, Comp, Alloc, Stats>::detach_root_() noexcept {
+  Subtree tree{root_(), black_height_(root_())};
+  reset_header_();
+  size_ = 0;
+  return tree;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::set_children_(
+    NodeBase *node, NodeBase *left, NodeBase *right) noexcept {
+  node->left_ = left;
+  node->right_ = right;
+  if (left != nullptr) left->parent_ = node;
+  if (right != nullptr) right->parent_ = node;
+  update_size_(node);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *
+Tree<K, V, Comp, Alloc, Stats>::rotate_sub_left_(NodeBase *node) noexcept {
+  NodeBase *pivot = node->right_;
+  node->right_ = pivot->left_;
+  if (node->right_ != nullptr) node->right_->parent_ = node;
+  pivot->left_ = node;
+  node->parent_ = pivot;
+  update_size_(node);
+  update_size_(pivot);
+  return pivot;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *
+Tree<K, V, Comp, Alloc, Stats>::rotate_sub_right_(NodeBase *node) noexcept {
+  NodeBase *pivot = node->left_;
+  node->left_ = pivot->right_;
+  if (node->left_ != nullptr) node->left_->parent_ = node;
+  pivot->right_ = node;
+  node->parent_ = pivot;
+  update_size_(node);
+  update_size_(pivot);
+  return pivot;
+}
+
+// Спуск по правому краю left до черного узла с высотой right; красный
+// pivot встает на его место, двойное красное исправляется поворотом выше.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *
+Tree<K, V, Comp, Alloc, Stats>::join_right_(NodeBase *left, int left_height,
+                                            NodeBase *pivot, NodeBase *right,
+                                            int right_height) noexcept {
+  if (!is_red_(left) && left_height == right_height) {
+    set_children_(pivot, left, right);
+    pivot->color_ = kRed;
+    return pivot;
+  }
+  int child_height = left_height - (is_red_(left) ? 0 : 1);
+  NodeBase *child =
+      join_right_(left->right_, child_height, pivot, right, right_height);
+  left->right_ = child;
+  child->parent_ = left;
+  update_size_(left);
+  if (!is_red_(left) && is_red_(child) && is_red_(child->right_)) {
+    child->right_->color_ = kBlack;
+    return rotate_sub_left_(left);
+  }
+  return left;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *
+Tree<K, V, Comp, Alloc, Stats>::join_left_(NodeBase *left, int left_height,
+                                           NodeBase *pivot, NodeBase *right,
+                                           int right_height) noexcept {
+  if (!is_red_(right) && left_height == right_height) {
+    set_children_(pivot, left, right);
+    pivot->color_ = kRed;
+    return pivot;
+  }
+  int child_height = right_height - (is_red_(right) ? 0 : 1);
+  NodeBase *child =
+      join_left_(left, left_height, pivot, right->left_, child_height);
+  right->left_ = child;
+  child->parent_ = right;
+  update_size_(right);
+  if (!is_red_(right) && is_red_(child) && is_red_(child->left_)) {
+    child->left_->color_ = kBlack;
+    return rotate_sub_right_(right);
+  }
+  return right;
+}
+
+// Все ключи left меньше pivot, а pivot меньше всех ключей right.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::Subtree
+Tree<K, V, Comp, Alloc, Stats>::join_(Subtree left, NodeBase *pivot,
+                                      Subtree right) noexcept {
+  if (left.black_height_ > right.black_height_) {
+    NodeBase *root = join_right_(left.root_, left.black_height_, pivot,
+                                 right.root_, right.black_height_);
+    if (is_red_(root) && is_red_(root->right_)) {
+      root->color_ = kBlack;
+      return {root, left.black_height_ + 1};
+    }
+    return {root, left.black_height_};
+  }
+  if (right.black_height_ > left.black_height_) {
+    NodeBase *root = join_left_(left.root_, left.black_height_, pivot,
+                                right.root_, right.black_height_);
+    if (is_red_(root) && is_red_(root->left_)) {
+      root->color_ = kBlack;
+      return {root, right.black_height_ + 1};
+    }
+    return {root, right.black_height_};
+  }
+  set_children_(pivot, left.root_, right.root_);
+  if (!is_red_(left.root_) && !is_red_(right.root_)) {
+    pivot->color_ = kRed;
+    return {pivot, left.black_height_};
+  }
+  pivot->color_ = kBlack;
+  return {pivot, left.black_height_ + 1};
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::Subtree
+Tree<K, V, Comp, Alloc, Stats>::join2_(Subtree left, Subtree right) noexcept {
+  if (left.root_ == nullptr) return right;
+  NodeBase *last = nullptr;
+  Subtree rest = split_last_(left, last);
+  return join_(rest, last, right);
+}
+
+// Отделяет максимум поддерева.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::Subtree
+Tree<K, V, Comp, Alloc, Stats>::split_last_(Subtree tree,
+                                            NodeBase *&last) noexcept {
+  NodeBase *node = tree.root_;
+  int child_height = tree.black_height_ - (is_red_(node) ? 0 : 1);
+  Subtree left{node->left_, child_height};
+  Subtree right{node->right_, child_height};
+  node->left_ = nullptr;
+  node->right_ = nullptr;
+  if (right.root_ == nullptr) {
+    last = node;
+    return left;
+  }
+  return join_(left, node, split_last_(right, last));
+}
+
+// Делит поддерево на ключи меньше key (результат), равный key (found) и
+// большие (right). В мультимножестве равные ключи уходят в right.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::Subtree
+Tree<K, V, Comp, Alloc, Stats>::split_(Subtree tree, const key_type &key,
+                                       NodeBase *&found, Subtree &right) const {
+  if (tree.root_ == nullptr) {
+    right = {nullptr, 0};
+    return tree;
+  }
+  NodeBase *node = tree.root_;
+  int child_height = tree.black_height_ - (is_red_(node) ? 0 : 1);
+  Subtree left{node->left_, child_height};
+  Subtree rest{node->right_, child_height};
+  node->left_ = nullptr;
+  node->right_ = nullptr;
+  int order = compare_(key, as_node_(node)->key());
+  if (order < 0 || (is_multi_set && order == 0)) {
+    Subtree middle{nullptr, 0};
+    Subtree less = split_(left, key, found, middle);
+    right = join_(middle, node, rest);
+    return less;
+  }
+  if (order > 0) {
+    Subtree middle = split_(rest, key, found, right);
+    return join_(left, node, middle);
+  }
+  found = node;
+  right = rest;
+  return left;
+}
+
+// Корень b делит a по своему ключу, половины обрабатываются независимо (на
+// верхних уровнях - в разных потоках) и снова соединяются через join.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::Subtree
+Tree<K, V, Comp, Alloc, Stats>::combine_(Subtree a, Subtree b, SetOperation op,
+                                         Garbage &garbage, int depth) const {
+  if (a.root_ == nullptr || b.root_ == nullptr) {
+    if (op == SetOperation::kIntersection) {
+      garbage.push(a.root_);
+      garbage.push(b.root_);
+      return {nullptr, 0};
+    }
+    if (op == SetOperation::kDifference) {
+      garbage.push(b.root_);
+      return a;
+    }
+    return a.root_ != nullptr ? a : b;
+  }
+  NodeBase *pivot = b.root_;
+  int child_height = b.black_height_ - (is_red_(pivot) ? 0 : 1);
+  Subtree b_left{pivot->left_, child_height};
+  Subtree b_right{pivot->right_, child_height};
+  pivot->left_ = nullptr;
+  pivot->right_ = nullptr;
+  NodeBase *found = nullptr;
+  Subtree a_right{nullptr, 0};
+  Subtree a_left = split_(a, as_node_(pivot)->key(), found, a_right);
+
+  Subtree left{nullptr, 0};
+  Subtree right{nullptr, 0};
+  std::future<Subtree> task;
+  Garbage right_garbage;
+  if (depth > 0 && child_height >= kParallelJoinHeight) {
+    try {
+      task = std::async(std::launch::async, [&]() {
+        return combine_(a_right, b_right, op, right_garbage, depth - 1);
+      });
+    } catch (const std::system_error &) {
+      // поток не создан: правая половина считается здесь же
+    }
+  }
+  left = combine_(a_left, b_left, op, garbage, depth - 1);
+  right = task.valid() ? task.get()
+                       : combine_(a_right, b_right, op, right_garbage, 0);
+  garbage.append(right_garbage);
+
+  switch (op) {
+    case SetOperation::kUnion:
+      if (found != nullptr) {
+        garbage.push(pivot);
+        pivot = found;
+      }
+      return join_(left, pivot, right);
+    case SetOperation::kIntersection:
+      garbage.push(pivot);
+      if (found != nullptr) return join_(left, found, right);
+      return join2_(left, right);
+    case SetOperation::kDifference:
+      garbage.push(pivot);
+      garbage.push(found);
+      return join2_(left, right);
+    default:
+      if (found == nullptr) return join_(left, pivot, right);
+      garbage.push(pivot);
+      garbage.push(found);
+      return join2_(left, right);
+  }
 }
 
-template <typename key_type, typename mapped_type>
+// Узлы создаются в порядке входа; пока ключи не убывают, они копятся в
+// nodes и затем связываются за O(n). Равные соседи в обычном дереве
+// отбрасываются (остается первый, как при обычной вставке).
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename InputIt>
+void Tree<K, V, Comp, Alloc, Stats>::assign_sorted(
+    InputIt first, InputIt last) {
+  clear();
+  Vector<Node *> nodes;
+  Node *unsorted = nullptr;
+  try {
+    for (; first != last && unsorted == nullptr; ++first) {
+      Node *node = create_from_(*first);
+      int order = 1;
+      if (!nodes.empty()) {
+        order = compare_(node->key(), nodes.back()->key());
+      }
+      if (order > 0) {
+        nodes.push_back(node);
+      } else if (order < 0) {
+        unsorted = node;
+      } else if (is_multi_set) {
+        nodes.push_back(node);
+      } else {
+        destroy_node_(node);
+      }
+    }
+  } catch (...) {
+    for (Node *node : nodes) destroy_node_(node);
+    throw;
+  }
+  link_sorted_(nodes);
+  if (unsorted != nullptr) {
+    bool to_left;
+    std::pair<NodeBase *, bool> pos =
+        find_insert_pos_(unsorted->key(), to_left);
+    if (pos.second) {
+      link_node_(unsorted, pos.first, to_left);
+    } else {
+      destroy_node_(unsorted);
+    }
+    for (; first != last; ++first) {
+      emplace_(*first);
+    }
+  }
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::assign_set_operation(
+    const Tree &a, const Tree &b, SetOperation op) {
+  if (this == &a || this == &b) {
+    Tree result{comp_, allocator_type(alloc_)};
+    result.is_multi_set = is_multi_set;
+    result.assign_set_operation(a, b, op);
+    clear();
+    swap(result);
+    return;
+  }
+  bool keep_a = op != SetOperation::kIntersection;
+  bool keep_b = op == SetOperation::kUnion ||
+                op == SetOperation::kSymmetricDifference;
+  bool keep_both =
+      op == SetOperation::kUnion || op == SetOperation::kIntersection;
+  NodeBase *x = a.header_.left_;
+  NodeBase *y = b.header_.left_;
+  const NodeBase *a_end = &a.header_;
+  const NodeBase *b_end = &b.header_;
+  clear();
+  Vector<Node *> nodes;
+  nodes.reserve(keep_b ? a.size_ + b.size_ : a.size_);
+  try {
+    while (x != a_end && y != b_end) {
+      const value_type &x_value = as_node_(x)->data_;
+      const value_type &y_value = as_node_(y)->data_;
+      int order =
+          compare_(value_traits::key(x_value), value_traits::key(y_value));
+      if (order < 0) {
+        if (keep_a) nodes.push_back(create_node_(x_value));
+        x = next_(x);
+      } else if (order > 0) {
+        if (keep_b) nodes.push_back(create_node_(y_value));
+        y = next_(y);
+      } else {
+        if (keep_both) nodes.push_back(create_node_(x_value));
+        x = next_(x);
+        y = next_(y);
+      }
+    }
+    for (; keep_a && x != a_end; x = next_(x)) {
+      nodes.push_back(create_node_(as_node_(x)->data_));
+    }
+    for (; keep_b && y != b_end; y = next_(y)) {
+      nodes.push_back(create_node_(as_node_(y)->data_));
+    }
+  } catch (...) {
+    for (Node *node : nodes) destroy_node_(node);
+    throw;
+  }
+  link_sorted_(nodes);
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+template <typename Elem>
+typename Tree<K, V, Comp, Alloc, Stats>::Node *
+Tree<K, V, Comp, Alloc, Stats>::create_from_(Elem &&elem) {
+  return create_node_(std::forward<Elem>(elem));
+}
+
+// Дерево пустое, nodes упорядочены. Глубже всех лежит только неполный
+// последний уровень: его узлы красные, остальные черные.
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+void Tree<K, V, Comp, Alloc, Stats>::link_sorted_(
+    Vector<Node *> &nodes) noexcept {
+  size_type count = nodes.size();
+  if (count == 0) return;
+  int red_depth = -1;
+  if (((count + 1) & count) != 0) {
+    red_depth = 0;
+    for (size_type rest = count; rest > 1; rest >>= 1) ++red_depth;
+  }
+  NodeBase *root = build_balanced_(nodes, 0, count, 0, red_depth);
+  root->parent_ = &header_;
+  header_.parent_ = root;
+  header_.left_ = nodes[0];
+  header_.right_ = nodes[count - 1];
+  size_ = count;
+}
+
+template <typename K, typename V, typename Comp, typename Alloc, typename Stats>
+typename Tree<K, V, Comp, Alloc, Stats>::NodeBase *
+Tree<K, V, Comp, Alloc, Stats>::build_balanced_(Vector<Node *> &nodes,
+                                                size_type first, size_type last,
+                                                int depth,
+                                                int red_depth) noexcept {
+  if (first == last) return nullptr;
+  size_type middle = first + (last - first) / 2;
+  NodeBase *node = nodes[middle];
+  node->color_ = depth == red_depth ? kRed : kBlack;
+  node->left_ = build_balanced_(nodes, first, middle, depth + 1, red_depth);
+  node->right_ = build_balanced_(nodes, middle + 1, last, depth + 1, red_depth);
+  if (node->left_ != nullptr) node->left_->parent_ = node;
+  if (node->right_ != nullptr) node->right_->parent_ = node;
+  update_size_(node);
+  return node;
+}
+
+template <typename key_type, typename mapped_type, typename Comp,
+          typename Alloc, typename Stats>
 template <typename... Args>
-Vector<std::pair<typename Tree<key_type, mapped_type>::iterator, bool>>
-Tree<key_type, mapped_type>::insert_many(Args &&...args) {
-  Vector<std::pair<typename Tree<key_type, mapped_type>::iterator, bool>> ret;
+Vector<std::pair<
+    typename Tree<key_type, mapped_type, Comp, Alloc, Stats>::iterator, bool>>
+Tree<key_type, mapped_type, Comp, Alloc, Stats>::insert_many(Args &&...args) {
+  Vector<std::pair<
+      typename Tree<key_type, mapped_type, Comp, Alloc, Stats>::iterator, bool>>
+      ret;
   ret.second = true;
   for (auto arg : {args...}) {
     if (contains(arg)) {
       ret.second = false;
     } else {
-      Tree<key_type, mapped_type>::push_(arg);
-      ret.first = Tree<key_type, mapped_type>::find_pos_(arg);
+      Tree<key_type, mapped_type, Comp, Alloc, Stats>::insert_value_(arg);
+      ret.first =
+          Tree<key_type, mapped_type, Comp, Alloc, Stats>::find_pos_(arg);
     }
   }
   return ret;
 }
 
+// Map, Set и Multiset: наследники Tree с любыми параметрами шаблона.
+template <typename C, typename = void>
+struct is_tree_container : std::false_type {};
+
+template <typename C>
+struct is_tree_container<C, std::void_t<typename C::tree_type>>
+    : std::is_base_of<typename C::tree_type, C> {};
+
+// Пустой контейнер с компаратором и аллокатором a, как при копировании.
+template <typename C>
+C empty_like_(const C &a) {
+  using traits = std::allocator_traits<typename C::allocator_type>;
+  return C(a.key_comp(),
+           traits::select_on_container_copy_construction(a.get_allocator()));
+}
+
+// Set algebra over two containers of the same type in O(n + m). The result
+// takes its comparator and allocator from a.
+template <typename C>
+std::enable_if_t<is_tree_container<C>::value, C> set_union(const C &a,
+                                                           const C &b) {
+  C result = empty_like_(a);
+  result.assign_set_operation(a, b, C::SetOperation::kUnion);
+  return result;
+}
+
+template <typename C>
+std::enable_if_t<is_tree_container<C>::value, C> set_intersection(
+    const C &a, const C &b) {
+  C result = empty_like_(a);
+  result.assign_set_operation(a, b, C::SetOperation::kIntersection);
+  return result;
+}
+
+template <typename C>
+std::enable_if_t<is_tree_container<C>::value, C> set_difference(const C &a,
+                                                                const C &b) {
+  C result = empty_like_(a);
+  result.assign_set_operation(a, b, C::SetOperation::kDifference);
+  return result;
+}
+
+template <typename C>
+std::enable_if_t<is_tree_container<C>::value, C> set_symmetric_difference(
+    const C &a, const C &b) {
+  C result = empty_like_(a);
+  result.assign_set_operation(a, b, C::SetOperation::kSymmetricDifference);
+  return result;
+}
+
 }  // namespace s21
 
 #endif  // S21_TREE_H_
\ No newline at end of file
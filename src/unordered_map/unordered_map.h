@@ -0,0 +1,222 @@
+#ifndef S21_UNORDERED_MAP_H
+#define S21_UNORDERED_MAP_H
+
+#include <tuple>
+#include <utility>
+
+#include "../hash_table/hash_table.h"
+
+namespace s21 {
+
+// Hash map for point lookups that never need key order. Values are stored
+// inline in an open-addressing table, so a hit usually costs one control
+// group load and one key comparison. Inserting may rehash and invalidate
+// iterators; erase invalidates only the erased one. Heterogeneous find,
+// contains and at need a transparent Hash as well as KeyEqual.
+template <typename K, typename T, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<>,
+          typename Alloc = std::allocator<std::pair<const K, T>>>
+class UnorderedMap : public HashTable<K, T, Hash, KeyEqual, Alloc> {
+ public:
+  using key_type = K;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename HashTable<K, T, Hash, KeyEqual, Alloc>::iterator;
+  using const_iterator =
+      typename HashTable<K, T, Hash, KeyEqual, Alloc>::const_iterator;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Alloc;
+
+  UnorderedMap() = default;
+  explicit UnorderedMap(size_type bucket_count, const hasher &hash = hasher(),
+                        const key_equal &equal = key_equal(),
+                        const allocator_type &alloc = allocator_type())
+      : HashTable<K, T, Hash, KeyEqual, Alloc>(bucket_count, hash, equal,
+                                               alloc) {}
+  UnorderedMap(std::initializer_list<value_type> const &items);
+  template <class InputIt, class = EnableIfIterator<InputIt>>
+  UnorderedMap(InputIt first, InputIt last);
+
+  mapped_type &at(const key_type &key) const;
+  template <typename Key,
+            typename = EnableIfTransparentHash<Hash, KeyEqual, Key>>
+  mapped_type &at(const Key &key) const;
+  mapped_type &operator[](const key_type &key);
+  mapped_type &operator[](key_type &&key);
+
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  std::pair<iterator, bool> insert(const key_type &key, const T &obj);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, const T &obj);
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, T &&obj);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args);
+
+  template <class... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+};
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+UnorderedMap<K, T, Hash, KeyEqual, Alloc>::UnorderedMap(
+    std::initializer_list<value_type> const &items) {
+  HashTable<K, T, Hash, KeyEqual, Alloc>::reserve(items.size());
+  for (const value_type &item : items) insert(item);
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+template <class InputIt, class>
+UnorderedMap<K, T, Hash, KeyEqual, Alloc>::UnorderedMap(InputIt first,
+                                                        InputIt last) {
+  for (; first != last; ++first) insert(*first);
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+T &UnorderedMap<K, T, Hash, KeyEqual, Alloc>::at(const key_type &key) const {
+  iterator it = HashTable<K, T, Hash, KeyEqual, Alloc>::find_(key);
+  if (it == HashTable<K, T, Hash, KeyEqual, Alloc>::end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+template <typename Key, typename>
+T &UnorderedMap<K, T, Hash, KeyEqual, Alloc>::at(const Key &key) const {
+  iterator it = HashTable<K, T, Hash, KeyEqual, Alloc>::find_(key);
+  if (it == HashTable<K, T, Hash, KeyEqual, Alloc>::end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+inline T &UnorderedMap<K, T, Hash, KeyEqual, Alloc>::operator[](
+    const key_type &key) {
+  return try_emplace(key).first->second;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+inline T &UnorderedMap<K, T, Hash, KeyEqual, Alloc>::operator[](
+    key_type &&key) {
+  return try_emplace(std::move(key)).first->second;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+inline std::pair<typename UnorderedMap<K, T, Hash, KeyEqual, Alloc>::iterator,
+                 bool>
+UnorderedMap<K, T, Hash, KeyEqual, Alloc>::insert(const value_type &value) {
+  return HashTable<K, T, Hash, KeyEqual, Alloc>::insert_unique_(value.first,
+                                                                value);
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+inline std::pair<typename UnorderedMap<K, T, Hash, KeyEqual, Alloc>::iterator,
+                 bool>
+UnorderedMap<K, T, Hash, KeyEqual, Alloc>::insert(value_type &&value) {
+  return HashTable<K, T, Hash, KeyEqual, Alloc>::insert_unique_(
+      value.first, std::move(value));
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+inline std::pair<typename UnorderedMap<K, T, Hash, KeyEqual, Alloc>::iterator,
+                 bool>
+UnorderedMap<K, T, Hash, KeyEqual, Alloc>::insert(const key_type &key,
+                                                  const T &obj) {
+  return HashTable<K, T, Hash, KeyEqual, Alloc>::insert_unique_(key, key,
+                                                                obj);
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+std::pair<typename UnorderedMap<K, T, Hash, KeyEqual, Alloc>::iterator, bool>
+UnorderedMap<K, T, Hash, KeyEqual, Alloc>::insert_or_assign(
+    const key_type &key, const T &obj) {
+  std::pair<iterator, bool> result = try_emplace(key, obj);
+  if (!result.second) {
+    result.first->second = obj;
+  }
+  return result;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+std::pair<typename UnorderedMap<K, T, Hash, KeyEqual, Alloc>::iterator, bool>
+UnorderedMap<K, T, Hash, KeyEqual, Alloc>::insert_or_assign(
+    const key_type &key, T &&obj) {
+  std::pair<iterator, bool> result = try_emplace(key, std::move(obj));
+  if (!result.second) {
+    result.first->second = std::move(obj);
+  }
+  return result;
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+template <class... Args>
+inline std::pair<typename UnorderedMap<K, T, Hash, KeyEqual, Alloc>::iterator,
+                 bool>
+UnorderedMap<K, T, Hash, KeyEqual, Alloc>::emplace(Args &&...args) {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+template <class... Args>
+inline std::pair<typename UnorderedMap<K, T, Hash, KeyEqual, Alloc>::iterator,
+                 bool>
+UnorderedMap<K, T, Hash, KeyEqual, Alloc>::try_emplace(const key_type &key,
+                                                       Args &&...args) {
+  return HashTable<K, T, Hash, KeyEqual, Alloc>::insert_unique_(
+      key, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+template <class... Args>
+inline std::pair<typename UnorderedMap<K, T, Hash, KeyEqual, Alloc>::iterator,
+                 bool>
+UnorderedMap<K, T, Hash, KeyEqual, Alloc>::try_emplace(key_type &&key,
+                                                       Args &&...args) {
+  return HashTable<K, T, Hash, KeyEqual, Alloc>::insert_unique_(
+      key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+// Место резервируется заранее: без перестройки вставка не двигает ячейки,
+// и возвращенные итераторы остаются верными.
+template <typename K, typename T, typename Hash, typename KeyEqual,
+          typename Alloc>
+template <class... Args>
+Vector<std::pair<typename UnorderedMap<K, T, Hash, KeyEqual, Alloc>::iterator,
+                 bool>>
+UnorderedMap<K, T, Hash, KeyEqual, Alloc>::insert_many(Args &&...args) {
+  HashTable<K, T, Hash, KeyEqual, Alloc>::reserve(
+      HashTable<K, T, Hash, KeyEqual, Alloc>::size() + sizeof...(Args));
+  Vector<std::pair<iterator, bool>> ret;
+  for (auto arg : {args...}) {
+    ret.push_back(insert(arg));
+  }
+  return ret;
+}
+
+}  // namespace s21
+
+#endif
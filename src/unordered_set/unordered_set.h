@@ -0,0 +1,101 @@
+#ifndef S21_UNORDERED_SET_H
+#define S21_UNORDERED_SET_H
+
+#include <utility>
+
+#include "../hash_table/hash_table.h"
+
+namespace s21 {
+
+// Hash set over the same open-addressing table as UnorderedMap.
+template <typename Value, typename Hash = std::hash<Value>,
+          typename KeyEqual = std::equal_to<>,
+          typename Alloc = std::allocator<Value>>
+class UnorderedSet : public HashTable<Value, void, Hash, KeyEqual, Alloc> {
+ public:
+  using key_type = Value;
+  using value_type = Value;
+  using iterator =
+      typename HashTable<Value, void, Hash, KeyEqual, Alloc>::iterator;
+  using const_iterator =
+      typename HashTable<Value, void, Hash, KeyEqual, Alloc>::const_iterator;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Alloc;
+
+  UnorderedSet() = default;
+  explicit UnorderedSet(size_type bucket_count, const hasher &hash = hasher(),
+                        const key_equal &equal = key_equal(),
+                        const allocator_type &alloc = allocator_type())
+      : HashTable<Value, void, Hash, KeyEqual, Alloc>(bucket_count, hash,
+                                                      equal, alloc) {}
+  UnorderedSet(std::initializer_list<value_type> const &items);
+  template <class InputIt, class = EnableIfIterator<InputIt>>
+  UnorderedSet(InputIt first, InputIt last);
+
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+
+  template <class... Args>
+  Vector<std::pair<iterator, bool>> insert_many(Args &&...args);
+};
+
+template <typename Value, typename Hash, typename KeyEqual, typename Alloc>
+UnorderedSet<Value, Hash, KeyEqual, Alloc>::UnorderedSet(
+    std::initializer_list<value_type> const &items) {
+  HashTable<Value, void, Hash, KeyEqual, Alloc>::reserve(items.size());
+  for (const value_type &item : items) insert(item);
+}
+
+template <typename Value, typename Hash, typename KeyEqual, typename Alloc>
+template <class InputIt, class>
+UnorderedSet<Value, Hash, KeyEqual, Alloc>::UnorderedSet(InputIt first,
+                                                         InputIt last) {
+  for (; first != last; ++first) insert(*first);
+}
+
+template <typename Value, typename Hash, typename KeyEqual, typename Alloc>
+inline std::pair<typename UnorderedSet<Value, Hash, KeyEqual, Alloc>::iterator,
+                 bool>
+UnorderedSet<Value, Hash, KeyEqual, Alloc>::insert(const value_type &value) {
+  return HashTable<Value, void, Hash, KeyEqual, Alloc>::insert_unique_(value,
+                                                                       value);
+}
+
+template <typename Value, typename Hash, typename KeyEqual, typename Alloc>
+inline std::pair<typename UnorderedSet<Value, Hash, KeyEqual, Alloc>::iterator,
+                 bool>
+UnorderedSet<Value, Hash, KeyEqual, Alloc>::insert(value_type &&value) {
+  return HashTable<Value, void, Hash, KeyEqual, Alloc>::insert_unique_(
+      value, std::move(value));
+}
+
+template <typename Value, typename Hash, typename KeyEqual, typename Alloc>
+template <class... Args>
+inline std::pair<typename UnorderedSet<Value, Hash, KeyEqual, Alloc>::iterator,
+                 bool>
+UnorderedSet<Value, Hash, KeyEqual, Alloc>::emplace(Args &&...args) {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+// Как в UnorderedMap::insert_many: после reserve итераторы не сдвигаются.
+template <typename Value, typename Hash, typename KeyEqual, typename Alloc>
+template <class... Args>
+Vector<std::pair<typename UnorderedSet<Value, Hash, KeyEqual, Alloc>::iterator,
+                 bool>>
+UnorderedSet<Value, Hash, KeyEqual, Alloc>::insert_many(Args &&...args) {
+  HashTable<Value, void, Hash, KeyEqual, Alloc>::reserve(
+      HashTable<Value, void, Hash, KeyEqual, Alloc>::size() + sizeof...(Args));
+  Vector<std::pair<iterator, bool>> ret;
+  for (auto arg : {args...}) {
+    ret.push_back(insert(arg));
+  }
+  return ret;
+}
+
+}  // namespace s21
+
+#endif
@@ -1,14 +1,49 @@
 #ifndef S21_VECTOR_H
 #define S21_VECTOR_H
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 
 namespace s21 {
 #define MAX_VECTOR_SIZE 21
 
+// Types whose objects can be moved to new storage by copying their bytes,
+// with the original then treated as raw memory. Vector relocates such
+// elements with memcpy/memmove instead of move-and-destroy. Opt a type in
+// by specializing this trait; it must not hold pointers into itself.
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+template <typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+// Категория итератора. Итераторы контейнеров s21 ее не объявляют, но все
+// они многопроходные.
+template <typename It, typename = void>
+struct IteratorCategory {
+  using type = std::forward_iterator_tag;
+};
+
+template <typename It>
+struct IteratorCategory<
+    It, std::void_t<typename std::iterator_traits<It>::iterator_category>> {
+  using type = typename std::iterator_traits<It>::iterator_category;
+};
+
 template <typename T>
 class Vector {
  public:
@@ -23,39 +58,36 @@ class Vector {
 
   Vector(size_type n) : Vector() {
     if (n > this->max_size()) throw std::invalid_argument("Invalid argument");
-    this->size_ = n;
-    this->capacity_ = n;
+    if (n == 0) return;
     // this->data_ = new value_type[n]{};
-    this->data_ = alloc_.allocate(n * sizeof(value_type));
-    for (size_type i = 0; i < n; ++i) {
-      this->data_[i] = 0; 
+    this->data_ = alloc_.allocate(n);
+    this->capacity_ = n;
+    for (; this->size_ < n; ++this->size_) {
+      alloc_traits::construct(alloc_, this->data_ + this->size_);
     }
   }
 
-  Vector(std::initializer_list<value_type> const &items) : alloc_() {
-    this->size_ = items.size();
-    this->capacity_ =
-        (items.size() < MAX_VECTOR_SIZE) ? MAX_VECTOR_SIZE : items.size();
+  Vector(std::initializer_list<value_type> const &items) : Vector() {
     // this->data_ = new value_type[capacity_]{};
-    this->data_ = alloc_.allocate(capacity_);
-
-    size_type index = 0;
-    for (value_type item : items) {
-      data_[index++] = item;
+    this->reserve((items.size() < MAX_VECTOR_SIZE) ? MAX_VECTOR_SIZE
+                                                   : items.size());
+    for (const_reference item : items) {
+      alloc_traits::construct(alloc_, this->data_ + this->size_, item);
+      ++this->size_;
     }
   }
 
-  Vector(const Vector &v) : alloc_() {
-    this->size_ = v.size_;
-    this->capacity_ = v.capacity_;
+  Vector(const Vector &v) : Vector() {
     // this->data_ = new value_type[v.capacity_];
-    this->data_ = alloc_.allocate(v.size());
-    for (size_type i = 0; i < this->size_; ++i) {
-      this->data_[i] = v.data_[i];
+    if (v.size_ == 0) return;
+    this->reserve(v.size_);
+    for (; this->size_ < v.size_; ++this->size_) {
+      alloc_traits::construct(alloc_, this->data_ + this->size_,
+                              v.data_[this->size_]);
     }
   }
 
-  Vector(Vector &&v) {
+  Vector(Vector &&v) noexcept {
     data_ = v.data_;
     size_ = v.size_;
     capacity_ = v.capacity_;
@@ -65,14 +97,9 @@ class Vector {
     v.capacity_ = 0;
   }
 
-  ~Vector() {
-    alloc_.deallocate(this->data_, this->capacity_);
-    this->size_ = 0;
-    this->capacity_ = 0;
-    this->data_ = nullptr;
-  }
+  ~Vector() { this->clear(); }
 
-  Vector<T> &operator=(Vector<T> &&v) {
+  Vector<T> &operator=(Vector<T> &&v) noexcept {
     if (this != &v) {
       this->swap(v);
       // delete[] v.data_;
@@ -112,21 +139,71 @@ class Vector {
       iterator pos,
       const_reference value);  // inserts elements into concrete pos and returns
                                // the iterator that points to the new element
+  iterator insert(iterator pos, value_type &&value);  // moves value into pos
+  iterator insert(const_iterator pos, size_type count,
+                  const_reference value);  // inserts count copies of value
+  template <class InputIt,
+            class = std::enable_if_t<!std::is_integral_v<InputIt>>>
+  iterator insert(const_iterator pos, InputIt first,
+                  InputIt last);  // inserts a copy of [first, last) at pos
+  template <class... Args>
+  iterator emplace(const_iterator pos,
+                   Args &&...args);  // constructs an element in place at pos
 
   void erase(iterator pos);               // erases element at pos
+  iterator erase(const_iterator first,
+                 const_iterator last);  // erases [first, last), returns the
+                                        // iterator following the last removed
   void push_back(const_reference value);  // adds an element to the end
-  void pop_back();                        // removes the last element
-  void swap(Vector &other);               // swaps the contents
+  void push_back(value_type &&value);     // moves value to the end
+  template <class... Args>
+  reference emplace_back(Args &&...args);  // constructs an element at the end
+  void pop_back();                         // removes the last element
+  void swap(Vector &other) noexcept;      // swaps the contents
 
   // -===Assistans===-
 
+  // Arguments that are elements of this vector are copied before the tail
+  // moves; other references into the vector must not be passed.
   template <class... Args>
   iterator insert_many(const_iterator pos, Args &&...args);
 
   template <class... Args>
   void insert_many_back(Args &&...args);
 
+  template <typename U, typename Pred>
+  friend typename Vector<U>::size_type erase_if(Vector<U> &v, Pred pred);
+
  private:
+  using alloc_traits = std::allocator_traits<std::allocator<T>>;
+
+  // Перенос побайтовый: после memcpy/memmove исходные объекты не
+  // разрушаются, их память просто считается сырой.
+  static constexpr bool kRelocatable = is_trivially_relocatable_v<T>;
+
+  // Переносит count элементов в неинициализированную память to. Исходные
+  // объекты остаются живыми, пока их не отпустит release_.
+  void relocate_(T *from, size_type count, T *to);
+  void release_(T *first, T *last) noexcept;
+  void destroy_(T *first, T *last) noexcept;
+  // Новый буфер на capacity элементов; старые элементы переносятся в него.
+  void reallocate_(size_type capacity);
+  // Освобождает count мест с позиции index и вызывает fill(cursor), который
+  // строит новые элементы подряд, сдвигая cursor. Буфер растет не больше
+  // одного раза, хвост сдвигается один раз.
+  template <class Fill>
+  iterator insert_gap_(size_type index, size_type count, Fill fill);
+  // Сдвигает хвост вправо: [gap, gap + count) становится сырой памятью.
+  void open_gap_(T *gap, size_type count);
+  // Обратное: сдвигает хвост [gap + count, last) влево на сырое место gap.
+  void close_gap_(T *gap, size_type count, T *last);
+  // Истинно, если value - элемент этого вектора.
+  template <class U>
+  bool points_into_(const U &value) const noexcept;
+  // Устойчиво убирает элементы, для которых pred истинен, за один проход.
+  template <class Pred>
+  size_type remove_if_(Pred pred);
+
   size_type size_;
   size_type capacity_;
   value_type* data_;
@@ -209,16 +286,7 @@ void Vector<T>::reserve(Vector<T>::size_type size) {
   if (size > max_size()) {
     throw std::length_error("Can't allocate memory of this size");
   }
-  if (size >= this->capacity()) {
-    // T *new_data = new T[size];
-    T *new_data = alloc_.allocate(size);
-
-    std::copy(this->begin(), this->end(), new_data);
-    alloc_.deallocate(data_, capacity_);
-    // delete[] data_;
-    data_ = new_data;
-    capacity_ = size;
-  }
+  if (size > this->capacity()) reallocate_(size);
 }
 
 template <typename T>
@@ -237,22 +305,14 @@ void Vector<T>::shrink_to_fit() {
   //   this->capacity_ = this->size_;
   // }
 
-  if (this->size_ < this->capacity_) {
-    T* new_array = alloc_.allocate(this->size_);
-    std::copy(this->data_, this->data_ + this->size_, new_array);
-    for (size_t i = 0; i < this->size_; ++i) {
-      alloc_.destroy(&this->data_[i]);
-    }
-    alloc_.deallocate(this->data_, this->capacity_);
-    this->data_ = new_array;
-    this->capacity_ = this->size_;
-  }
+  if (this->size_ < this->capacity_) reallocate_(this->size_);
 }
 
 // -===Modifiers===-
 template <typename T>
 void Vector<T>::clear() {
   // if (this->data_ != nullptr) delete[] this->data_;
+  destroy_(this->data_, this->data_ + this->size_);
   if (this->data_ != nullptr) this->alloc_.deallocate(this->data_, this->capacity_);
   this->size_ = 0;
   this->capacity_ = 0;
@@ -260,57 +320,159 @@ void Vector<T>::clear() {
 }
 
 template <typename T>
-typename Vector<T>::iterator Vector<T>::insert(iterator pos,
-                                               const_reference value) {
-  if (pos == end()) {
-    push_back(value);
-    pos = end();
-    return --pos;
-  }
-
-  size_type diff = pos - begin();
+inline typename Vector<T>::iterator Vector<T>::insert(iterator pos,
+                                                      const_reference value) {
+  return emplace(pos, value);
+}
 
-  if (this->size_ >= this->capacity_)
-    reserve(this->capacity_ ? this->capacity_ * 2 : 1);
+template <typename T>
+inline typename Vector<T>::iterator Vector<T>::insert(iterator pos,
+                                                      value_type &&value) {
+  return emplace(pos, std::move(value));
+}
 
-  auto insert_pos = begin() + diff;
-  pos = insert_pos;
+template <typename T>
+typename Vector<T>::iterator Vector<T>::insert(const_iterator pos,
+                                               size_type count,
+                                               const_reference value) {
+  if (points_into_(value)) {
+    // Сдвиг затронет сам value, поэтому вставляется его копия.
+    T copy(value);
+    return insert(pos, count, copy);
+  }
+  return insert_gap_(pos - begin(), count, [&](T *&cursor) {
+    for (size_type i = 0; i < count; ++i) {
+      alloc_traits::construct(alloc_, cursor, value);
+      ++cursor;
+    }
+  });
+}
 
-  T evicted_item = *pos;
-  *pos = value;
-  pos++;
+// Однопроходные итераторы не дают узнать длину заранее: элементы
+// дописываются в конец и одним поворотом ставятся на место.
+template <typename T>
+template <class InputIt, class>
+typename Vector<T>::iterator Vector<T>::insert(const_iterator pos,
+                                               InputIt first, InputIt last) {
+  size_type index = pos - begin();
+  using category = typename IteratorCategory<InputIt>::type;
+  if constexpr (std::is_same_v<category, std::input_iterator_tag>) {
+    size_type old_size = this->size_;
+    for (; first != last; ++first) emplace_back(*first);
+    std::rotate(begin() + index, begin() + old_size, end());
+    return begin() + index;
+  } else {
+    size_type count = 0;
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                    category>) {
+      count = last - first;
+    } else {
+      for (InputIt it = first; it != last; ++it) ++count;
+    }
+    return insert_gap_(index, count, [&](T *&cursor) {
+      for (; first != last; ++first) {
+        alloc_traits::construct(alloc_, cursor, *first);
+        ++cursor;
+      }
+    });
+  }
+}
 
-  for (; pos != end(); ++pos) {
-    std::swap(*pos, evicted_item);
+template <typename T>
+template <class... Args>
+typename Vector<T>::iterator Vector<T>::emplace(const_iterator pos,
+                                                Args &&...args) {
+  size_type diff = pos - begin();
+  if (diff == this->size_) {
+    emplace_back(std::forward<Args>(args)...);
+    return end() - 1;
+  }
+  if (this->size_ == this->capacity_) {
+    return insert_gap_(diff, 1, [&](T *&cursor) {
+      alloc_traits::construct(alloc_, cursor, std::forward<Args>(args)...);
+      ++cursor;
+    });
+  }
+  // Аргументы могут ссылаться на элементы вектора, поэтому значение
+  // строится до сдвига.
+  T item(std::forward<Args>(args)...);
+  iterator insert_pos = begin() + diff;
+  if constexpr (kRelocatable) {
+    open_gap_(insert_pos, 1);
+    alloc_traits::construct(alloc_, insert_pos, std::move(item));
+    ++size_;
+    return insert_pos;
   }
+  alloc_traits::construct(alloc_, end(), std::move(*(end() - 1)));
   ++size_;
+  std::move_backward(insert_pos, end() - 2, end() - 1);
+  *insert_pos = std::move(item);
   return insert_pos;
 }
 
 template <typename T>
-void Vector<T>::push_back(const_reference value) {
-  if (this->size_ == this->capacity_)
-    reserve(this->capacity_ ? this->capacity_ * 2 : 1);
+inline void Vector<T>::push_back(const_reference value) {
+  emplace_back(value);
+}
 
-  this->data_[size_++] = value;
+template <typename T>
+inline void Vector<T>::push_back(value_type &&value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T>
+template <class... Args>
+typename Vector<T>::reference Vector<T>::emplace_back(Args &&...args) {
+  if (this->size_ < this->capacity_) {
+    alloc_traits::construct(alloc_, this->data_ + size_,
+                            std::forward<Args>(args)...);
+    ++size_;
+  } else {
+    insert_gap_(size_, 1, [&](T *&cursor) {
+      alloc_traits::construct(alloc_, cursor, std::forward<Args>(args)...);
+      ++cursor;
+    });
+  }
+  return this->data_[size_ - 1];
 }
 
 template <typename T>
 void Vector<T>::erase(iterator pos) {
-  if (pos < this->begin() || pos > this->end()) {
+  if (pos < this->begin() || pos >= this->end()) {
     throw std::out_of_range("Erase position is out of range");
   }
-  for (iterator it = pos; it != this->end() - 1; ++it) *it = *(it + 1);
+  if constexpr (kRelocatable) {
+    destroy_(pos, pos + 1);
+    close_gap_(pos, 1, this->end());
+  } else {
+    std::move(pos + 1, this->end(), pos);
+    alloc_traits::destroy(alloc_, this->end() - 1);
+  }
   --this->size_;
 }
 
+template <typename T>
+typename Vector<T>::iterator Vector<T>::erase(const_iterator first,
+                                              const_iterator last) {
+  if (first < this->begin() || last > this->end() || first > last) {
+    throw std::out_of_range("Erase range is out of range");
+  }
+  T *gap = begin() + (first - begin());
+  size_type count = last - first;
+  if (count == 0) return gap;
+  destroy_(gap, gap + count);
+  close_gap_(gap, count, end());
+  this->size_ -= count;
+  return gap;
+}
+
 template <typename T>
 void Vector<T>::pop_back() {
-  if (this->size_ > 0) --this->size_;
+  if (this->size_ > 0) alloc_traits::destroy(alloc_, this->data_ + --size_);
 }
 
 template <typename T>
-void Vector<T>::swap(Vector &other) {
+void Vector<T>::swap(Vector &other) noexcept {
   std::swap(this->data_, other.data_);
   std::swap(this->size_, other.size_);
   std::swap(this->capacity_, other.capacity_);
@@ -318,6 +480,207 @@ void Vector<T>::swap(Vector &other) {
 }
 // -===Assistans===-
 
+// Тривиально перемещаемые элементы переносятся одним memcpy. Остальные
+// перемещаются, если перемещение не бросает исключений, иначе копируются:
+// при ошибке старый буфер остается нетронутым.
+template <typename T>
+void Vector<T>::relocate_(T *from, size_type count, T *to) {
+  if constexpr (kRelocatable) {
+    if (count != 0) {
+      std::memcpy(static_cast<void *>(to), static_cast<const void *>(from),
+                  count * sizeof(T));
+    }
+  } else {
+    size_type done = 0;
+    try {
+      for (; done < count; ++done) {
+        alloc_traits::construct(alloc_, to + done,
+                                std::move_if_noexcept(from[done]));
+      }
+    } catch (...) {
+      destroy_(to, to + done);
+      throw;
+    }
+  }
+}
+
+template <typename T>
+void Vector<T>::destroy_(T *first, T *last) noexcept {
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    for (; first != last; ++first) alloc_traits::destroy(alloc_, first);
+  }
+}
+
+template <typename T>
+inline void Vector<T>::release_(T *first, T *last) noexcept {
+  if constexpr (!kRelocatable) destroy_(first, last);
+}
+
+template <typename T>
+void Vector<T>::reallocate_(size_type capacity) {
+  T *new_data = capacity ? alloc_.allocate(capacity) : nullptr;
+  try {
+    relocate_(this->data_, this->size_, new_data);
+  } catch (...) {
+    if (new_data != nullptr) alloc_.deallocate(new_data, capacity);
+    throw;
+  }
+  release_(this->data_, this->data_ + this->size_);
+  if (this->data_ != nullptr) alloc_.deallocate(this->data_, this->capacity_);
+  this->data_ = new_data;
+  this->capacity_ = capacity;
+}
+
+// При росте новые элементы строятся в новом буфере раньше, чем старые
+// переносятся и разрушаются, так что fill может читать из вектора. Если
+// fill бросит исключение, хвост возвращается на место.
+template <typename T>
+template <class Fill>
+typename Vector<T>::iterator Vector<T>::insert_gap_(size_type index,
+                                                    size_type count,
+                                                    Fill fill) {
+  if (count == 0) return begin() + index;
+  if (this->size_ + count > this->capacity_) {
+    size_type capacity = this->capacity_ * 2;
+    if (capacity < this->size_ + count) capacity = this->size_ + count;
+    T *new_data = alloc_.allocate(capacity);
+    T *cursor = new_data + index;
+    try {
+      fill(cursor);
+    } catch (...) {
+      destroy_(new_data + index, cursor);
+      alloc_.deallocate(new_data, capacity);
+      throw;
+    }
+    bool prefix = false;
+    try {
+      relocate_(this->data_, index, new_data);
+      prefix = true;
+      relocate_(this->data_ + index, this->size_ - index,
+                new_data + index + count);
+    } catch (...) {
+      if (prefix) destroy_(new_data, new_data + index);
+      destroy_(new_data + index, new_data + index + count);
+      alloc_.deallocate(new_data, capacity);
+      throw;
+    }
+    release_(this->data_, this->data_ + this->size_);
+    if (this->data_ != nullptr) {
+      alloc_.deallocate(this->data_, this->capacity_);
+    }
+    this->data_ = new_data;
+    this->capacity_ = capacity;
+  } else {
+    T *gap = this->data_ + index;
+    open_gap_(gap, count);
+    T *cursor = gap;
+    try {
+      fill(cursor);
+    } catch (...) {
+      destroy_(gap, cursor);
+      close_gap_(gap, count, this->data_ + this->size_ + count);
+      throw;
+    }
+  }
+  this->size_ += count;
+  return begin() + index;
+}
+
+// Часть хвоста, уходящая за старый конец, строится перемещением, остальная
+// сдвигается присваиванием; перемещенные объекты в промежутке разрушаются.
+template <typename T>
+void Vector<T>::open_gap_(T *gap, size_type count) {
+  T *last = this->data_ + this->size_;
+  if constexpr (kRelocatable) {
+    if (last != gap) {
+      std::memmove(static_cast<void *>(gap + count),
+                   static_cast<const void *>(gap), (last - gap) * sizeof(T));
+    }
+  } else {
+    size_type tail = last - gap;
+    size_type raw = tail < count ? tail : count;
+    for (T *from = last - raw; from != last; ++from) {
+      alloc_traits::construct(alloc_, from + count, std::move(*from));
+    }
+    std::move_backward(gap, last - raw, last - raw + count);
+    destroy_(gap, gap + raw);
+  }
+}
+
+template <typename T>
+void Vector<T>::close_gap_(T *gap, size_type count, T *last) {
+  size_type tail = last - gap - count;
+  if constexpr (kRelocatable) {
+    if (tail != 0) {
+      std::memmove(static_cast<void *>(gap),
+                   static_cast<const void *>(gap + count), tail * sizeof(T));
+    }
+  } else {
+    size_type raw = tail < count ? tail : count;
+    for (size_type i = 0; i < raw; ++i) {
+      alloc_traits::construct(alloc_, gap + i, std::move(gap[count + i]));
+    }
+    std::move(gap + count + raw, last, gap + raw);
+    destroy_(gap + (tail > count ? tail : count), last);
+  }
+}
+
+template <typename T>
+template <class U>
+inline bool Vector<T>::points_into_(const U &value) const noexcept {
+  if constexpr (std::is_same_v<U, T>) {
+    const T *item = std::addressof(value);
+    return !std::less<const T *>()(item, begin()) &&
+           std::less<const T *>()(item, end());
+  } else {
+    return false;
+  }
+}
+
+// Удаляемый элемент разрушается сразу, а оставшиеся отрезки между
+// удаляемыми переносятся на освободившееся место: memmove для тривиально
+// перемещаемых типов, перемещающее присваивание для остальных. Если pred
+// бросает, непросмотренный хвост сдвигается к out, чтобы разрушенные
+// элементы не остались внутри [begin(), end()).
+template <typename T>
+template <class Pred>
+typename Vector<T>::size_type Vector<T>::remove_if_(Pred pred) {
+  T *last = end();
+  T *out = std::find_if(begin(), last, pred);
+  if constexpr (kRelocatable) {
+    for (T *it = out; it != last;) {
+      destroy_(it, it + 1);
+      T *run = ++it;
+      try {
+        while (it != last && !pred(*it)) ++it;
+      } catch (...) {
+        if (last != run) {
+          std::memmove(static_cast<void *>(out),
+                       static_cast<const void *>(run),
+                       (last - run) * sizeof(T));
+        }
+        this->size_ -= run - out;
+        throw;
+      }
+      if (it != run) {
+        std::memmove(static_cast<void *>(out), static_cast<const void *>(run),
+                     (it - run) * sizeof(T));
+      }
+      out += it - run;
+    }
+  } else {
+    if (out != last) {
+      for (T *it = out + 1; it != last; ++it) {
+        if (!pred(*it)) *out++ = std::move(*it);
+      }
+    }
+    destroy_(out, last);
+  }
+  size_type removed = last - out;
+  this->size_ -= removed;
+  return removed;
+}
+
 template <typename T>
 template <typename... Args>
 typename Vector<T>::iterator Vector<T>::insert_many(const_iterator pos,
@@ -325,19 +688,36 @@ typename Vector<T>::iterator Vector<T>::insert_many(const_iterator pos,
   if (pos < this->begin() || pos > this->end())
     throw std::out_of_range("Insert position is out of range");
 
-  Vector<T> tmp{args...};
-  iterator current_pos = begin() + (pos - begin());
-  for (size_t i = 0; i < tmp.size(); ++i) {
-    current_pos = insert(current_pos, tmp[i]);
-    ++current_pos;
+  // Без роста хвост сдвигается раньше, чем строятся новые элементы, и
+  // аргумент-элемент оказался бы сдвинут: аргументы сначала копируются.
+  if (this->size_ + sizeof...(Args) <= this->capacity_ &&
+      (points_into_(args) || ...)) {
+    return insert_many(pos, T(std::forward<Args>(args))...);
   }
-  return current_pos;
+  size_type index = pos - begin();
+  insert_gap_(index, sizeof...(Args), [&](T *&cursor) {
+    ((alloc_traits::construct(alloc_, cursor, std::forward<Args>(args)),
+      ++cursor),
+     ...);
+  });
+  return begin() + index + sizeof...(Args);
 }
 
 template <typename T>
 template <typename... Args>
 void Vector<T>::insert_many_back(Args &&...args) {
-  this->insert_many(end(), args...);
+  insert_gap_(this->size_, sizeof...(Args), [&](T *&cursor) {
+    ((alloc_traits::construct(alloc_, cursor, std::forward<Args>(args)),
+      ++cursor),
+     ...);
+  });
+}
+
+// Removes every element satisfying pred in one stable pass and returns how
+// many were removed.
+template <typename T, typename Pred>
+typename Vector<T>::size_type erase_if(Vector<T> &v, Pred pred) {
+  return v.remove_if_(pred);
 }
 
 }  // namespace s21